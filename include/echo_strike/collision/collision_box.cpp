@@ -1,21 +1,35 @@
 #include <echo_strike/collision/collision_box.hpp>
 
+#include <echo_strike/core/world.hpp>
 #include <echo_strike/physics/object.hpp>
 #include <echo_strike/collision/collision_manager.hpp>
 
 CollisionBox::CollisionBox()
-    : m_object(nullptr),
-      m_enable(true)
+    : m_dirty(false),
+      m_static(false),
+      m_sensor(false),
+      m_id(0),
+      m_enable(true),
+      m_shape(ShapeType::Rect),
+      m_object(nullptr),
+      m_world(nullptr)
 {
 }
 
 CollisionBox::CollisionBox(CollisionBox &&other) noexcept
     : collide_callback(std::move(other.collide_callback)),
-      m_enable(other.m_enable),
-      m_src(other.m_src),
       m_dst(std::move(other.m_dst)),
       m_rect(std::move(other.m_rect)),
-      m_object(other.m_object)
+      m_tree_rect(other.m_tree_rect),
+      m_dirty(false),
+      m_static(other.m_static),
+      m_sensor(other.m_sensor),
+      m_id(other.m_id),
+      m_enable(other.m_enable),
+      m_src(other.m_src),
+      m_shape(other.m_shape),
+      m_object(other.m_object),
+      m_world(other.m_world)
 {
     other.m_src = CollisionLayer::None;
     other.m_dst.clear();
@@ -30,14 +44,33 @@ CollisionBox &CollisionBox::operator=(CollisionBox &&other) noexcept
     collide_callback = std::move(other.collide_callback);
     m_enable = other.m_enable;
     m_src = other.m_src, other.m_src = CollisionLayer::None;
+    m_shape = other.m_shape;
     m_dst = std::move(other.m_dst), other.m_dst.clear();
     m_rect = std::move(other.m_rect);
+    m_tree_rect = other.m_tree_rect;
     m_object = other.m_object, other.m_object = nullptr;
+    m_world = other.m_world;
+    m_id = other.m_id;
 
     return *this;
 }
 
 std::vector<CollisionBox *> CollisionBox::process_collide() const
+{
+    auto result = process_collide(m_rect);
+
+    // 包围盒相交之后再按实际形状做一次窄阶段筛选。
+    std::erase_if(
+        result,
+        [this](CollisionBox *other)
+        { return !is_intersect(*other); });
+    return result;
+}
+
+/**
+ * @brief 以任意范围 (例如运动包围盒) 查询碰撞, 不修改自身在四叉树中的位置。
+ */
+std::vector<CollisionBox *> CollisionBox::process_collide(const Rect &range) const
 {
     std::vector<CollisionBox *> result;
 
@@ -47,7 +80,12 @@ std::vector<CollisionBox *> CollisionBox::process_collide() const
     if (m_src == CollisionLayer::None || m_dst.empty())
         return result;
 
-    auto collide_result = CollisionManager::instance().quad_tree().query(m_rect);
+    // 静态盒子之间不会发生碰撞, 静态盒子只需查询动态索引。
+    // 触发器索引不在这里查询, 因此物理的 TOI 与穿透修正会完全跳过传感器。
+    auto &manager = m_world->collision();
+    auto collide_result = manager.quad_tree().query(range);
+    if (!m_static || m_sensor)
+        manager.static_tree().query(range, collide_result);
     result.reserve(collide_result.size());
 
     for (auto dst_box : collide_result)
@@ -69,9 +107,15 @@ std::vector<CollisionBox *> CollisionBox::process_collide() const
 
 void CollisionBox::set_rect(const Rect &rect)
 {
-    // CollisionManager::instance().quad_tree().update(m_rect, rect, this);
-    CollisionManager::instance().quad_tree().update(rect, this);
+    // 只记录新位置, 由 CollisionManager::flush 在下次查询前批量同步到四叉树。
     m_rect = rect;
+    if (m_static && !m_sensor)
+        m_world->collision().mark_static_dirty();
+    else if (!m_dirty)
+    {
+        m_dirty = true;
+        m_world->collision().mark_dirty(this);
+    }
 }
 
 void CollisionBox::set_object(Object *obj)
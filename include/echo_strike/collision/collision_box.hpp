@@ -5,6 +5,7 @@
 #include <echo_strike/utils/color.hpp>
 
 #include <echo_strike/collision/collision_layer.hpp>
+#include <echo_strike/collision/collision_shape.hpp>
 
 #include <SDL3/SDL.h>
 
@@ -13,6 +14,7 @@
 
 class CollisionManager;
 class Object;
+class World;
 
 class CollisionBox
 {
@@ -28,12 +30,20 @@ private:
 
     Set<CollisionLayer> m_dst;
     Rect m_rect;
+    Rect m_tree_rect; // 上次放入四叉树时的矩形, 删除时只需搜索与之相交的节点
+    bool m_dirty;  // m_rect 已修改但尚未同步进四叉树
+    bool m_static; // 属于静态索引, 由 CollisionManager::set_static 切换
+    bool m_sensor; // 传感器/触发器: 只报告重叠, 不参与物理求解, 由 CollisionManager::set_sensor 切换
+    size_t m_id;   // 由 CollisionManager 分配的单调递增编号, 用于确定性排序
 
     CLASS_PROPERTY(bool, enable)
 
     CLASS_PROPERTY(CollisionLayer, src)
 
+    CLASS_PROPERTY(ShapeType, shape)
+
     Object *m_object;
+    World *m_world; // 所属世界, 由创建它的 CollisionManager 设置
 
 private:
     CollisionBox();
@@ -54,6 +64,7 @@ public:
     void render_border(SDL_Renderer *renderer) const { m_rect.render_border(renderer); }
 
     std::vector<CollisionBox *> process_collide() const;
+    std::vector<CollisionBox *> process_collide(const Rect &range) const;
 
 public:
     Set<CollisionLayer> &get_dst() { return m_dst; }
@@ -65,8 +76,29 @@ public:
     Rect get_rect() const { return m_rect; }
     void set_rect(const Rect &rect);
 
+    // 圆形/胶囊体由包围盒推导, 设置时同时更新形状标签与包围盒。
+    Circle get_circle() const { return Circle::inscribed(m_rect); }
+    void set_circle(const Circle &circle) { m_shape = ShapeType::Circle, set_rect(circle.bounding_box()); }
+
+    Capsule get_capsule() const { return Capsule::inscribed(m_rect); }
+
+    bool is_intersect(const CollisionBox &other) const
+    {
+        return shape_intersect(m_shape, m_rect, other.m_shape, other.m_rect);
+    }
+    float time_to_collide(const Vec2 &velocity, const CollisionBox &other) const
+    {
+        return shape_time_to_collide(m_shape, m_rect, velocity, other.m_shape, other.m_rect);
+    }
+    bool is_dirty() const { return m_dirty; }
+    bool is_static() const { return m_static; }
+    bool is_sensor() const { return m_sensor; }
+    size_t get_id() const { return m_id; }
+
     Object *get_object() const { return m_object; }
     void set_object(Object *);
+
+    World *get_world() const { return m_world; }
 };
 
 #endif // INCLUDE_COLLISION_BOX
\ No newline at end of file
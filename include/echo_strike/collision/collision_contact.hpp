@@ -0,0 +1,15 @@
+#ifndef INCLUDE_COLLISION_CONTACT
+#define INCLUDE_COLLISION_CONTACT
+
+class CollisionBox;
+
+// 窄阶段确认的一次接触, a 总是 id 较小的一方, 用于保证派发顺序确定。
+struct CollisionContact
+{
+    CollisionBox *a;
+    CollisionBox *b;
+    bool a_hits_b; // a 的目标层包含 b 的源层, 需要触发 b 的回调
+    bool b_hits_a; // b 的目标层包含 a 的源层, 需要触发 a 的回调
+};
+
+#endif // INCLUDE_COLLISION_CONTACT
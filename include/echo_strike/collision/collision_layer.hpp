@@ -1,6 +1,8 @@
 #ifndef INCLUDE_COLLISION_LAYER
 #define INCLUDE_COLLISION_LAYER
 
+#include <cstdint>
+
 enum class CollisionLayer
 {
     None,
@@ -10,4 +12,15 @@ enum class CollisionLayer
     Physics
 };
 
-#endif // INCLUDE_COLLISION_LAYER
\ No newline at end of file
+// 层掩码: 每个层占一位, 一次查询可以同时筛选多个层。
+using CollisionLayerMask = std::uint32_t;
+
+constexpr CollisionLayerMask ALL_COLLISION_LAYERS = ~CollisionLayerMask(0);
+
+template <typename... Layers>
+constexpr CollisionLayerMask layer_mask(Layers... layers)
+{
+    return ((CollisionLayerMask(1) << static_cast<unsigned>(layers)) | ... | CollisionLayerMask(0));
+}
+
+#endif // INCLUDE_COLLISION_LAYER
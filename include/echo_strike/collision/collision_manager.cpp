@@ -1,25 +1,38 @@
 #include <echo_strike/collision/collision_manager.hpp>
 
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/event/events.hpp>
+#include <echo_strike/event/event_bus.hpp>
+
 #include <algorithm>
 #include <iostream>
 #include <utility>
 
-CollisionManager::CollisionManager()
-    : m_quad_tree(Rect(0, 0, 800, 600))
+CollisionManager::CollisionManager(World &world, const Rect &bound)
+    : m_world(&world),
+      m_quad_tree(bound),
+      m_static_tree(bound),
+      m_static_dirty(false),
+      m_trigger_tree(bound),
+      m_next_id(0),
+      m_batch_event(std::make_shared<CollisionBatchEvent>()),
+      m_pair_count(0)
 {
 }
 
 CollisionManager &CollisionManager::instance()
 {
-    static CollisionManager manager;
-    return manager;
+    return World::instance().collision();
 }
 
-CollisionBox *CollisionManager::create_collision_box()
+CollisionBox *CollisionManager::create_collision_box(bool is_static)
 {
     auto box = new CollisionBox();
+    box->m_id = m_next_id++;
+    box->m_world = m_world;
+    box->m_static = is_static;
     boxes.push_back(box);
-    m_quad_tree.insert(Rect{}, box);
+    attach(box);
     return box;
 }
 
@@ -31,15 +44,170 @@ void CollisionManager::destroy_collision_box(CollisionBox *box)
             boxes.end(),
             box));
 
-    // m_quad_tree.remove(box->get_rect(), box);
-    m_quad_tree.remove(box);
+    detach(box);
     delete box;
 }
 
+TileCollisionMap &CollisionManager::create_tile_map(const Point &origin, float cell_size, int cols, int rows)
+{
+    m_tile_map = std::make_unique<TileCollisionMap>(origin, cell_size, cols, rows);
+    return *m_tile_map;
+}
+
+void CollisionManager::overlap_rect(const Rect &rect, CollisionLayerMask mask, std::vector<CollisionBox *> &out) const
+{
+    overlap_shape(ShapeType::Rect, rect, mask, out);
+}
+
+void CollisionManager::overlap_point(const Vec2 &point, CollisionLayerMask mask, std::vector<CollisionBox *> &out) const
+{
+    overlap_shape(ShapeType::Rect, Rect(Point(point), Vec2()), mask, out);
+}
+
+void CollisionManager::overlap_circle(const Circle &circle, CollisionLayerMask mask, std::vector<CollisionBox *> &out) const
+{
+    overlap_shape(ShapeType::Circle, circle.bounding_box(), mask, out);
+}
+
+/**
+ * @brief 三种重叠查询的公共实现: 形状由标签和包围盒描述, 与 CollisionBox 相同。
+ * 候选直接写进 out 再原地筛选, 不使用额外的缓冲区。
+ * 索引里记录的是上次 flush 时的位置, 因此脏盒子不取自索引, 而是按当前位置单独检查;
+ * 静态索引待重建时同理, 直接遍历静态盒子。
+ */
+void CollisionManager::overlap_shape(ShapeType shape, const Rect &range, CollisionLayerMask mask, std::vector<CollisionBox *> &out) const
+{
+    auto accept = [&](const CollisionBox *box)
+    {
+        return box->m_enable &&
+               (mask & layer_mask(box->m_src)) &&
+               shape_intersect(box->m_shape, box->m_rect, shape, range);
+    };
+
+    size_t base = out.size();
+    m_quad_tree.query(range, out);
+    m_trigger_tree.query(range, out);
+    if (!m_static_dirty)
+        m_static_tree.query(range, out);
+
+    out.erase(
+        std::remove_if(
+            out.begin() + base,
+            out.end(),
+            [&](const CollisionBox *box)
+            { return box->m_dirty || !accept(box); }),
+        out.end());
+
+    for (auto box : m_dirty_boxes)
+        if (accept(box))
+            out.push_back(box);
+
+    if (m_static_dirty)
+        for (auto box : m_static_boxes)
+            if (accept(box))
+                out.push_back(box);
+}
+
+void CollisionManager::set_static(CollisionBox *box, bool is_static)
+{
+    if (box->m_static == is_static)
+        return;
+
+    detach(box);
+    box->m_static = is_static;
+    attach(box);
+}
+
+void CollisionManager::set_sensor(CollisionBox *box, bool is_sensor)
+{
+    if (box->m_sensor == is_sensor)
+        return;
+
+    detach(box);
+    box->m_sensor = is_sensor;
+    attach(box);
+}
+
+/**
+ * @brief 按盒子的标记放入对应的索引: 传感器 > 静态 > 动态。
+ */
+void CollisionManager::attach(CollisionBox *box)
+{
+    if (box->m_sensor)
+    {
+        m_sensor_boxes.push_back(box);
+        index_box(m_trigger_tree, box);
+    }
+    else if (box->m_static)
+    {
+        m_static_boxes.push_back(box);
+        m_static_dirty = true;
+    }
+    else
+        index_box(m_quad_tree, box);
+}
+
+void CollisionManager::detach(CollisionBox *box)
+{
+    if (box->m_dirty)
+    {
+        m_dirty_boxes.erase(
+            std::find(
+                m_dirty_boxes.begin(),
+                m_dirty_boxes.end(),
+                box));
+        box->m_dirty = false;
+    }
+
+    if (box->m_sensor)
+    {
+        m_sensor_boxes.erase(
+            std::find(
+                m_sensor_boxes.begin(),
+                m_sensor_boxes.end(),
+                box));
+        unindex_box(m_trigger_tree, box);
+    }
+    else if (box->m_static)
+    {
+        m_static_boxes.erase(
+            std::find(
+                m_static_boxes.begin(),
+                m_static_boxes.end(),
+                box));
+        m_static_dirty = true;
+    }
+    else
+        unindex_box(m_quad_tree, box);
+}
+
+void CollisionManager::index_box(QuadTree<CollisionBox> &tree, CollisionBox *box)
+{
+    tree.insert(box->m_rect, box);
+    box->m_tree_rect = box->m_rect;
+}
+
+/**
+ * @brief 按放入时的矩形删除, 只搜索相交的节点; 不带矩形的 remove 要遍历整棵树,
+ * 大量物体每帧移动时 flush 的开销会随物体数平方增长。
+ * 之前插入失败 (越界) 的盒子按矩形找不到, 退回到遍历。
+ */
+void CollisionManager::unindex_box(QuadTree<CollisionBox> &tree, CollisionBox *box)
+{
+    if (!tree.remove(box->m_tree_rect, box))
+        tree.remove(box);
+}
+
 void CollisionManager::debug_render(SDL_Renderer *renderer) const
 {
     for (auto box : boxes)
         box->render_border(renderer);
+
+    if (m_tile_map)
+        m_tile_map->for_each_tile(
+            m_tile_map->bound(),
+            [renderer](const Rect &cell, TileType)
+            { cell.render_border(renderer); });
 }
 
 CollisionManager::~CollisionManager()
@@ -53,17 +221,179 @@ void CollisionManager::clear()
     for (auto &box : destroy_boxes)
         destroy_collision_box(box);
     boxes.clear();
+    destroy_tile_map();
+}
+
+void CollisionManager::flush()
+{
+    if (m_static_dirty)
+    {
+        m_static_tree.clear();
+        for (auto box : m_static_boxes)
+            m_static_tree.insert(box->m_rect, box);
+        m_static_dirty = false;
+    }
+
+    if (m_dirty_boxes.empty())
+        return;
+
+    for (auto box : m_dirty_boxes)
+    {
+        // 不用 update: 之前插入失败 (越界) 的盒子也要有机会重新进入四叉树。
+        auto &tree = box->m_sensor ? m_trigger_tree : m_quad_tree;
+        unindex_box(tree, box);
+        index_box(tree, box);
+        box->m_dirty = false;
+    }
+    m_dirty_boxes.clear();
+}
+
+void CollisionManager::set_worker_count(size_t count)
+{
+    if (count <= 1)
+        m_pool.reset();
+    else if (get_worker_count() != count)
+        m_pool = std::make_unique<ThreadPool>(count - 1);
 }
 
 void CollisionManager::process_collide()
 {
-    for (auto src_box : boxes)
+    // 先收集再派发: 回调里可能会修改四叉树 (例如 set_rect), 不能边遍历边回调。
+    flush();
+    collect_pairs();
+    narrow_phase();
+
+    for (auto &contact : m_contacts)
+        dispatch_contact(contact);
+
+    publish_contacts();
+}
+
+void CollisionManager::publish_contacts()
+{
+    if (m_contacts.empty())
+        return;
+
+    m_batch_event->set_contacts(m_contacts);
+    m_world->events().publish(m_batch_event);
+    m_batch_event->set_contacts({});
+}
+
+void CollisionManager::collect_pairs()
+{
+    m_pairs.clear();
+    m_quad_tree.query_pairs(
+        [this](CollisionBox *a, CollisionBox *b)
+        { m_pairs.emplace_back(a, b); });
+
+    // 动态-静态: 从数量较少的一侧发起查询; 静态-静态直接跳过。
+    size_t dynamic_count = boxes.size() - m_static_boxes.size() - m_sensor_boxes.size();
+    if (m_static_boxes.size() < dynamic_count)
     {
-        auto dst_boxes = src_box->process_collide();
-        for (auto dst_box : dst_boxes)
+        for (auto box : m_static_boxes)
+            query_into_pairs(m_quad_tree, box);
+    }
+    else
+    {
+        for (auto box : boxes)
+            if (!box->m_static && !box->m_sensor)
+                query_into_pairs(m_static_tree, box);
+    }
+
+    // 传感器只在这里与动态/静态盒子配对, 每帧一次; 传感器之间互不触发。
+    for (auto box : m_sensor_boxes)
+    {
+        query_into_pairs(m_quad_tree, box);
+        query_into_pairs(m_static_tree, box);
+    }
+
+    m_pair_count = m_pairs.size();
+}
+
+void CollisionManager::query_into_pairs(const QuadTree<CollisionBox> &tree, CollisionBox *box)
+{
+    m_candidates.clear();
+    tree.query(box->m_rect, m_candidates);
+    for (auto other : m_candidates)
+        m_pairs.emplace_back(box, other);
+}
+
+void CollisionManager::narrow_phase()
+{
+    m_contacts.clear();
+
+    if (!m_pool || m_pairs.size() < PARALLEL_MIN_PAIRS)
+    {
+        CollisionContact contact;
+        for (auto &[a, b] : m_pairs)
+            if (test_pair(a, b, contact))
+                m_contacts.push_back(contact);
+    }
+    else
+    {
+        m_chunk_contacts.resize(m_pool->chunk_count());
+        m_pool->parallel_for(
+            m_pairs.size(),
+            [this](size_t begin, size_t end, size_t chunk)
+            {
+                auto &buffer = m_chunk_contacts[chunk];
+                buffer.clear();
+
+                CollisionContact contact;
+                for (size_t i = begin; i < end; ++i)
+                    if (test_pair(m_pairs[i].first, m_pairs[i].second, contact))
+                        buffer.push_back(contact);
+            });
+
+        for (auto &buffer : m_chunk_contacts)
         {
-            if (dst_box->collide_callback)
-                dst_box->collide_callback(*src_box);
+            m_contacts.insert(m_contacts.end(), buffer.begin(), buffer.end());
+            buffer.clear();
         }
     }
-}
\ No newline at end of file
+
+    // 按 id 排序, 使派发顺序与线程数和四叉树内部布局无关。
+    std::sort(
+        m_contacts.begin(),
+        m_contacts.end(),
+        [](const CollisionContact &lhs, const CollisionContact &rhs)
+        {
+            if (lhs.a->m_id != rhs.a->m_id)
+                return lhs.a->m_id < rhs.a->m_id;
+            return lhs.b->m_id < rhs.b->m_id;
+        });
+}
+
+/**
+ * @brief 窄阶段: 过滤禁用/无层的盒子并判断双方的目标层, 只读访问, 可在工作线程中调用。
+ * @return 至少一方需要被通知时返回 true, 结果写入 contact。
+ */
+bool CollisionManager::test_pair(CollisionBox *a, CollisionBox *b, CollisionContact &contact)
+{
+    if (!a->get_enable() || !b->get_enable())
+        return false;
+
+    if (a->get_src() == CollisionLayer::None || b->get_src() == CollisionLayer::None)
+        return false;
+
+    if (!a->is_intersect(*b))
+        return false;
+
+    if (a->m_id > b->m_id)
+        std::swap(a, b);
+
+    contact.a = a;
+    contact.b = b;
+    contact.a_hits_b = a->has_dst(b->get_src());
+    contact.b_hits_a = b->has_dst(a->get_src());
+    return contact.a_hits_b || contact.b_hits_a;
+}
+
+void CollisionManager::dispatch_contact(const CollisionContact &contact)
+{
+    // 一次检测同时触发双方: a 的目标层包含 b 时通知 b, 反之亦然。
+    if (contact.a_hits_b && contact.b->collide_callback)
+        contact.b->collide_callback(*contact.a);
+    if (contact.b_hits_a && contact.a->collide_callback)
+        contact.a->collide_callback(*contact.b);
+}
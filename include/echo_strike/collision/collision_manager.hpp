@@ -2,41 +2,138 @@
 #define INCLUDE_COLLISION_MANAGER
 
 #include <echo_strike/utils/quadtree.hpp>
+#include <echo_strike/core/thread_pool.hpp>
 #include <echo_strike/collision/collision_box.hpp>
+#include <echo_strike/collision/collision_contact.hpp>
+#include <echo_strike/collision/tile_collision_map.hpp>
 
 #include <SDL3/SDL.h>
 
+class CollisionBatchEvent;
+class World;
+
+#include <memory>
+#include <utility>
 #include <vector>
 
 class CollisionManager
 {
+    friend class World;
+
+public:
+    using BoxPair = std::pair<CollisionBox *, CollisionBox *>;
+
 public:
     static CollisionManager &instance();
-    CollisionBox *create_collision_box();
+    CollisionBox *create_collision_box(bool is_static = false);
     void destroy_collision_box(CollisionBox *);
 
     void debug_render(SDL_Renderer *) const;
 
 private:
+    World *m_world;
     std::vector<CollisionBox *> boxes;
     QuadTree<CollisionBox> m_quad_tree;
+    std::vector<BoxPair> m_pairs;
+    std::vector<CollisionBox *> m_dirty_boxes;
+
+    // 静态索引: 只存放不会移动的盒子 (例如墙体), 仅在其集合或位置变化后整体重建一次。
+    std::vector<CollisionBox *> m_static_boxes;
+    QuadTree<CollisionBox> m_static_tree;
+    bool m_static_dirty;
+
+    // 触发器索引: 传感器盒子只报告重叠, 物理查询 (TOI / 穿透修正) 不会访问这棵树。
+    std::vector<CollisionBox *> m_sensor_boxes;
+    QuadTree<CollisionBox> m_trigger_tree;
+
+    // 关卡的网格几何, 不占用任何碰撞盒; 物理与实体移动在查询动态索引的同时查询它。
+    std::unique_ptr<TileCollisionMap> m_tile_map;
+
+    std::vector<CollisionBox *> m_candidates;
+
+    // 窄阶段结果: 并行模式下每个分块写入独立缓冲区, 合并后按 id 排序再在主线程派发。
+    std::vector<CollisionContact> m_contacts;
+    std::vector<std::vector<CollisionContact>> m_chunk_contacts;
+    std::unique_ptr<ThreadPool> m_pool;
+    size_t m_next_id;
+
+    // 复用同一个事件对象, 每帧只发布一次, 不随接触数量分配内存。
+    std::shared_ptr<CollisionBatchEvent> m_batch_event;
+
+    // 候选对少于该值时并行的调度开销不划算, 直接串行处理。
+    static constexpr size_t PARALLEL_MIN_PAIRS = 1024;
+
+    CLASS_READONLY_PROPERTY(size_t, pair_count)
 
 private:
-    CollisionManager();
+    CollisionManager(World &, const Rect &bound);
+
+public:
     ~CollisionManager();
 
 public:
+    World &world() { return *m_world; }
+
     size_t size() const { return boxes.size(); }
     void clear();
 
     std::vector<CollisionBox *> &collision_boxes() { return boxes; }
     const std::vector<CollisionBox *> &collision_boxes() const { return boxes; }
 
-    QuadTree<CollisionBox> &quad_tree() { return m_quad_tree; }
-    const QuadTree<CollisionBox> &quad_tree() const { return m_quad_tree; }
+    // 访问前先 flush, 保证调用者看到的索引不会过期。
+    QuadTree<CollisionBox> &quad_tree() { return flush(), m_quad_tree; }
+    QuadTree<CollisionBox> &static_tree() { return flush(), m_static_tree; }
+    QuadTree<CollisionBox> &trigger_tree() { return flush(), m_trigger_tree; }
+
+    const std::vector<CollisionBox *> &static_boxes() const { return m_static_boxes; }
+    const std::vector<CollisionBox *> &sensor_boxes() const { return m_sensor_boxes; }
+
+    // 直接查询与给定形状重叠、且所在层属于 mask 的已启用盒子, 结果追加到 out。
+    // 动态、静态与触发器索引都会查询; 不创建盒子、不修改索引, 尚未 flush 的移动也会按当前位置计入。
+    void overlap_rect(const Rect &, CollisionLayerMask, std::vector<CollisionBox *> &out) const;
+    void overlap_point(const Vec2 &, CollisionLayerMask, std::vector<CollisionBox *> &out) const;
+    void overlap_circle(const Circle &, CollisionLayerMask, std::vector<CollisionBox *> &out) const;
+
+    // 同一时刻只有一张网格, 重新创建会替换旧的; 没有网格时 tile_map() 返回空。
+    TileCollisionMap &create_tile_map(const Point &origin, float cell_size, int cols, int rows);
+    void destroy_tile_map() { m_tile_map.reset(); }
+    TileCollisionMap *tile_map() { return m_tile_map.get(); }
+    const TileCollisionMap *tile_map() const { return m_tile_map.get(); }
+
+    // 最近一次 process_collide 产生的接触, 已按 (a, b) 的 id 排序。
+    const std::vector<CollisionContact> &contacts() const { return m_contacts; }
+
+    // 0 或 1 表示串行; 大于 1 时窄阶段在 worker_count - 1 个工作线程加调用线程上并行。
+    void set_worker_count(size_t);
+    size_t get_worker_count() const { return m_pool ? m_pool->chunk_count() : 1; }
 
 public:
+    void set_static(CollisionBox *, bool);
+    void set_sensor(CollisionBox *, bool);
+
+    void mark_dirty(CollisionBox *box) { m_dirty_boxes.push_back(box); }
+    void mark_static_dirty() { m_static_dirty = true; }
+    void flush();
+
     void process_collide();
+
+private:
+    void attach(CollisionBox *);
+    void detach(CollisionBox *);
+
+    // 放入/移出动态或触发器索引, 并记录放入时的矩形。
+    void index_box(QuadTree<CollisionBox> &tree, CollisionBox *box);
+    void unindex_box(QuadTree<CollisionBox> &tree, CollisionBox *box);
+
+    void overlap_shape(ShapeType, const Rect &, CollisionLayerMask, std::vector<CollisionBox *> &out) const;
+
+    void collect_pairs();
+    void query_into_pairs(const QuadTree<CollisionBox> &, CollisionBox *);
+    void narrow_phase();
+    void publish_contacts();
+
+    static bool test_pair(CollisionBox *, CollisionBox *, CollisionContact &);
+    static void dispatch_contact(const CollisionContact &);
 };
 
 #endif // INCLUDE_COLLISION_MANAGER
\ No newline at end of file
@@ -0,0 +1,170 @@
+#include <echo_strike/collision/collision_shape.hpp>
+
+#include <cmath>
+
+static constexpr int pair_key(ShapeType a, ShapeType b)
+{
+    return static_cast<int>(a) * 3 + static_cast<int>(b);
+}
+
+bool shape_intersect(ShapeType a_type, const Rect &a, ShapeType b_type, const Rect &b)
+{
+    switch (pair_key(a_type, b_type))
+    {
+    case pair_key(ShapeType::Rect, ShapeType::Rect):
+        return a.is_intersect(b);
+    case pair_key(ShapeType::Rect, ShapeType::Circle):
+        return Circle::inscribed(b).is_intersect(a);
+    case pair_key(ShapeType::Rect, ShapeType::Capsule):
+        return Capsule::inscribed(b).is_intersect(a);
+
+    case pair_key(ShapeType::Circle, ShapeType::Rect):
+        return Circle::inscribed(a).is_intersect(b);
+    case pair_key(ShapeType::Circle, ShapeType::Circle):
+        return Circle::inscribed(a).is_intersect(Circle::inscribed(b));
+    case pair_key(ShapeType::Circle, ShapeType::Capsule):
+        return Capsule::inscribed(b).is_intersect(Circle::inscribed(a));
+
+    case pair_key(ShapeType::Capsule, ShapeType::Rect):
+        return Capsule::inscribed(a).is_intersect(b);
+    case pair_key(ShapeType::Capsule, ShapeType::Circle):
+        return Capsule::inscribed(a).is_intersect(Circle::inscribed(b));
+    case pair_key(ShapeType::Capsule, ShapeType::Capsule):
+        return Capsule::inscribed(a).is_intersect(Capsule::inscribed(b));
+    }
+    return false;
+}
+
+float shape_time_to_collide(ShapeType a_type, const Rect &a, const Vec2 &velocity, ShapeType b_type, const Rect &b)
+{
+    // 交换主次时相对速度取反: a 以 v 撞向 b 等价于 b 以 -v 撞向 a。
+    switch (pair_key(a_type, b_type))
+    {
+    case pair_key(ShapeType::Rect, ShapeType::Rect):
+        return a.time_to_collide(velocity, b);
+    case pair_key(ShapeType::Rect, ShapeType::Circle):
+        return Circle::inscribed(b).time_to_collide(-velocity, a);
+    case pair_key(ShapeType::Rect, ShapeType::Capsule):
+        return Capsule::inscribed(b).time_to_collide(-velocity, a);
+
+    case pair_key(ShapeType::Circle, ShapeType::Rect):
+        return Circle::inscribed(a).time_to_collide(velocity, b);
+    case pair_key(ShapeType::Circle, ShapeType::Circle):
+        return Circle::inscribed(a).time_to_collide(velocity, Circle::inscribed(b));
+    case pair_key(ShapeType::Circle, ShapeType::Capsule):
+        return Capsule::inscribed(b).time_to_collide(-velocity, Circle::inscribed(a));
+
+    case pair_key(ShapeType::Capsule, ShapeType::Rect):
+        return Capsule::inscribed(a).time_to_collide(velocity, b);
+    case pair_key(ShapeType::Capsule, ShapeType::Circle):
+        return Capsule::inscribed(a).time_to_collide(velocity, Circle::inscribed(b));
+    case pair_key(ShapeType::Capsule, ShapeType::Capsule):
+        return Capsule::inscribed(a).time_to_collide(velocity, Capsule::inscribed(b));
+    }
+    return -1;
+}
+
+// 圆和胶囊体统一看作线段外扩半径, 圆的线段退化为一点。
+struct RoundShape
+{
+    Vec2 a, b;
+    float radius;
+};
+
+static RoundShape round_shape(ShapeType type, const Rect &rect)
+{
+    if (type == ShapeType::Circle)
+    {
+        Circle circle = Circle::inscribed(rect);
+        return {circle.get_center(), circle.get_center(), circle.get_radius()};
+    }
+    Capsule capsule = Capsule::inscribed(rect);
+    return {capsule.get_a(), capsule.get_b(), capsule.get_radius()};
+}
+
+static void box_contact(const Rect &a, const Rect &b, Vec2 &normal, float &separation)
+{
+    Vec2 n = a.center() - b.center();
+    float overlap_x = (a.get_width() + b.get_width()) * 0.5f - std::abs(n.get_x());
+    float overlap_y = (a.get_height() + b.get_height()) * 0.5f - std::abs(n.get_y());
+    if (overlap_x < overlap_y)
+    {
+        normal = Vec2(n.get_x() > 0 ? 1.0f : -1.0f, 0);
+        separation = -overlap_x;
+    }
+    else
+    {
+        normal = Vec2(0, n.get_y() > 0 ? 1.0f : -1.0f);
+        separation = -overlap_y;
+    }
+}
+
+// 由最近点对 (pa 属于 a 的核心, pb 属于 b 的核心) 得到法线和间距, 两点重合时返回 false。
+static bool contact_from_points(const Vec2 &pa, const Vec2 &pb, float radius, Vec2 &normal, float &separation)
+{
+    Vec2 d = pa - pb;
+    float distance = d.length();
+    if (distance < 1e-6f)
+        return false;
+    normal = d / distance;
+    separation = distance - radius;
+    return true;
+}
+
+// 两条不相交线段之间的最近点总有一个是端点。
+static bool round_round_contact(const RoundShape &a, const RoundShape &b, Vec2 &normal, float &separation)
+{
+    if (is_segment_intersect(a.a, a.b, b.a, b.b))
+        return false;
+
+    Vec2 best_a = a.a, best_b = closest_point_on_segment(a.a, b.a, b.b);
+    float best = (best_a - best_b).dot(best_a - best_b);
+    auto consider = [&](const Vec2 &pa, const Vec2 &pb)
+    {
+        float d = (pa - pb).dot(pa - pb);
+        if (d < best)
+            best = d, best_a = pa, best_b = pb;
+    };
+    consider(a.b, closest_point_on_segment(a.b, b.a, b.b));
+    consider(closest_point_on_segment(b.a, a.a, a.b), b.a);
+    consider(closest_point_on_segment(b.b, a.a, a.b), b.b);
+    return contact_from_points(best_a, best_b, a.radius + b.radius, normal, separation);
+}
+
+// 线段与矩形不相交时, 最近点在线段端点或矩形的角上。
+static bool round_rect_contact(const RoundShape &a, const Rect &b, Vec2 &normal, float &separation)
+{
+    if (b.is_inside(Point(a.a)) || is_segment_intersect_rect(a.a, a.b, b))
+        return false;
+
+    Vec2 best_a = a.a, best_b = closest_point_on_rect(a.a, b);
+    float best = (best_a - best_b).dot(best_a - best_b);
+    auto consider = [&](const Vec2 &pa, const Vec2 &pb)
+    {
+        float d = (pa - pb).dot(pa - pb);
+        if (d < best)
+            best = d, best_a = pa, best_b = pb;
+    };
+    consider(a.b, closest_point_on_rect(a.b, b));
+    for (const Vec2 &corner : {b.top_left(), b.top_right(), b.bottom_left(), b.bottom_right()})
+        consider(closest_point_on_segment(corner, a.a, a.b), corner);
+    return contact_from_points(best_a, best_b, a.radius, normal, separation);
+}
+
+void shape_contact(ShapeType a_type, const Rect &a, ShapeType b_type, const Rect &b, Vec2 &normal, float &separation)
+{
+    bool found = false;
+    if (a_type != ShapeType::Rect && b_type != ShapeType::Rect)
+        found = round_round_contact(round_shape(a_type, a), round_shape(b_type, b), normal, separation);
+    else if (a_type != ShapeType::Rect)
+        found = round_rect_contact(round_shape(a_type, a), b, normal, separation);
+    else if (b_type != ShapeType::Rect)
+    {
+        found = round_rect_contact(round_shape(b_type, b), a, normal, separation);
+        normal = -normal;
+    }
+
+    // 核心已经相交 (深度穿透) 时最近点连线没有方向, 用包围盒推开
+    if (!found)
+        box_contact(a, b, normal, separation);
+}
@@ -0,0 +1,32 @@
+#ifndef INCLUDE_COLLISION_SHAPE
+#define INCLUDE_COLLISION_SHAPE
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/transform/circle.hpp>
+#include <echo_strike/transform/capsule.hpp>
+
+#include <cstdint>
+
+/*
+    碰撞盒的形状标签。形状的具体几何由标签和包围盒共同决定:
+    Rect 即包围盒本身, Circle 为其内切圆, Capsule 为沿较长边的内切胶囊体。
+    因此宽阶段仍只使用包围盒, 窄阶段按标签对 switch 派发, 不需要虚函数。
+*/
+enum class ShapeType : std::uint8_t
+{
+    Rect,
+    Circle,
+    Capsule
+};
+
+bool shape_intersect(ShapeType, const Rect &, ShapeType, const Rect &);
+
+// 形状 a 以 velocity 运动时与静止的形状 b 的最早碰撞时间, 约定同 Rect::time_to_collide。
+float shape_time_to_collide(ShapeType, const Rect &, const Vec2 &velocity, ShapeType, const Rect &);
+
+// 两个形状之间的接触法线 (从 b 指向 a) 和沿法线的间距, 负数表示重叠。
+// 两个矩形取重叠量最小的轴; 圆和胶囊体取最近点连线, 核心线段已经相交时退回包围盒的最小重叠轴。
+void shape_contact(ShapeType, const Rect &a, ShapeType, const Rect &b, Vec2 &normal, float &separation);
+
+#endif // INCLUDE_COLLISION_SHAPE
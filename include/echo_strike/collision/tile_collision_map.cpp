@@ -0,0 +1,309 @@
+#include <echo_strike/collision/tile_collision_map.hpp>
+
+#include <limits>
+
+// 容差: 恰好贴在格子边上的矩形不算重叠, 避免沿地面滑动时被相邻的地面格子挡住。
+static constexpr float SKIN = 1e-3f;
+
+TileCollisionMap::TileCollisionMap(const Point &origin, float cell_size, int cols, int rows)
+    : m_origin(origin),
+      m_cell_size(cell_size),
+      m_cols(std::max(cols, 0)),
+      m_rows(std::max(rows, 0)),
+      m_tiles(m_cols * m_rows, TileType::Empty)
+{
+}
+
+void TileCollisionMap::set_tile(int col, int row, TileType type)
+{
+    if (col < 0 || row < 0 || col >= m_cols || row >= m_rows)
+        return;
+    m_tiles[row * m_cols + col] = type;
+}
+
+void TileCollisionMap::fill(int col, int row, int cols, int rows, TileType type)
+{
+    for (int r = row; r < row + rows; ++r)
+        for (int c = col; c < col + cols; ++c)
+            set_tile(c, r, type);
+}
+
+void TileCollisionMap::clear()
+{
+    std::fill(m_tiles.begin(), m_tiles.end(), TileType::Empty);
+}
+
+bool TileCollisionMap::is_intersect(const Rect &rect) const
+{
+    int col_begin = std::max(col_of(rect.left()), 0), col_end = std::min(col_of(rect.right()), m_cols - 1);
+    int row_begin = std::max(row_of(rect.bottom()), 0), row_end = std::min(row_of(rect.top()), m_rows - 1);
+
+    for (int row = row_begin; row <= row_end; ++row)
+        for (int col = col_begin; col <= col_end; ++col)
+            if (m_tiles[row * m_cols + col] == TileType::Solid)
+                return true;
+    return false;
+}
+
+/**
+ * @brief 碰撞时间由较晚进入的那条轴决定。如果进入的那个面与相邻的非空格子共用 (内部边),
+ * 说明物体只是贴着表面滑过两块砖的接缝, 不算碰撞; 单向平台只有上表面算数。
+ * 起始时已接触的格子, 只有当物体正朝它的外表面运动时才返回 0。
+ *
+ * 不遍历整个运动包围盒 (斜向高速运动时是 O(dx·dy) 个格子), 而是按时间顺序推进矩形覆盖的行列范围 (DDA):
+ * 前沿每跨过一条格线, 只检查新进入的那一列 (或一行) 与当前覆盖范围相交的格子, 后沿离开的行列不再检查。
+ * 每个格子只在被覆盖时检查一次, 总数与矩形扫过的格子数成正比; 找到碰撞后, 晚于它进入的格子不可能更早相撞, 直接结束。
+ */
+float TileCollisionMap::time_to_collide(const Rect &rect, const Vec2 &velocity, float max_time, Rect *hit_cell) const
+{
+    float vx = velocity.get_x(), vy = velocity.get_y();
+    const float inf = std::numeric_limits<float>::infinity();
+
+    // 只在矩形与网格范围重叠的时间段内遍历, 网格之外的行列不需要逐个跨过
+    float t_begin = 0, t_end = max_time;
+    Rect grid = bound();
+    auto clip = [&](float lo, float hi, float min, float max, float v)
+    {
+        if (v == 0)
+            return max >= lo && min <= hi;
+        float t0 = (lo - max) / v, t1 = (hi - min) / v;
+        if (t0 > t1)
+            std::swap(t0, t1);
+        t_begin = std::max(t_begin, t0), t_end = std::min(t_end, t1);
+        return t_begin <= t_end;
+    };
+    if (!clip(grid.left(), grid.right(), rect.left(), rect.right(), vx) ||
+        !clip(grid.bottom(), grid.top(), rect.bottom(), rect.top(), vy))
+        return -1;
+
+    float first = -1;
+    auto test = [&](int col, int row)
+    {
+        TileType type = get_tile(col, row);
+        if (type == TileType::Empty)
+            return;
+
+        Rect cell = cell_rect(col, row);
+        if (type == TileType::OneWay && (vy <= 0 || rect.top() > cell.bottom() + SKIN))
+            return;
+
+        float t = rect.time_to_collide(velocity, cell);
+        if (t < 0 || t > max_time || (first >= 0 && t >= first))
+            return;
+
+        if (t <= 1e-6f)
+        {
+            // 起始时已接触: 法线取最小穿透轴, 只有朝格子的外表面运动时才算碰撞。
+            Vec2 n = rect.center() - cell.center();
+            float overlap_x = (rect.get_width() + cell.get_width()) * 0.5f - std::abs(n.get_x());
+            float overlap_y = (rect.get_height() + cell.get_height()) * 0.5f - std::abs(n.get_y());
+
+            int dir_x = 0, dir_y = 0;
+            if (overlap_x < overlap_y)
+                dir_x = n.get_x() > 0 ? 1 : -1;
+            else
+                dir_y = n.get_y() > 0 ? 1 : -1;
+
+            if (type == TileType::OneWay && dir_y != -1)
+                return;
+            if (get_tile(col + dir_x, row + dir_y) != TileType::Empty)
+                return;
+            if (vx * dir_x + vy * dir_y >= 0)
+                return;
+
+            first = 0;
+            if (hit_cell)
+                *hit_cell = cell;
+            return;
+        }
+
+        float enter_x = vx > 0   ? (cell.left() - rect.right()) / vx
+                        : vx < 0 ? (cell.right() - rect.left()) / vx
+                                 : -inf;
+        float enter_y = vy > 0   ? (cell.bottom() - rect.top()) / vy
+                        : vy < 0 ? (cell.top() - rect.bottom()) / vy
+                                 : -inf;
+
+        bool face_x = enter_x >= enter_y;
+        bool face_y = enter_y >= enter_x;
+
+        if (face_x && (type == TileType::OneWay || get_tile(col - (vx > 0 ? 1 : -1), row) != TileType::Empty))
+            face_x = false;
+        if (face_y && get_tile(col, row - (vy > 0 ? 1 : -1)) != TileType::Empty)
+            face_y = false;
+        if (!face_x && !face_y)
+            return;
+
+        first = t;
+        if (hit_cell)
+            *hit_cell = cell;
+    };
+
+    // 检查 [col_lo, col_hi] x [row_lo, row_hi] 中位于网格内的格子
+    auto test_range = [&](int col_lo, int col_hi, int row_lo, int row_hi)
+    {
+        for (int row = std::max(row_lo, 0); row <= std::min(row_hi, m_rows - 1); ++row)
+            for (int col = std::max(col_lo, 0); col <= std::min(col_hi, m_cols - 1); ++col)
+                test(col, row);
+    };
+
+    Rect start = rect + velocity * t_begin;
+    int col_lo = col_of(start.left()), col_hi = col_of(start.right());
+    int row_lo = row_of(start.bottom()), row_hi = row_of(start.top());
+    test_range(col_lo, col_hi, row_lo, row_hi);
+
+    auto grid_x = [&](int col) { return m_origin.get_x() + col * m_cell_size; };
+    auto grid_y = [&](int row) { return m_origin.get_y() + row * m_cell_size; };
+
+    while (true)
+    {
+        // 前沿进入下一列/行、后沿离开当前第一列/行的时间, 与 col_of/row_of 的取整方式一致
+        float enter_x = vx > 0   ? (grid_x(col_hi + 1) - rect.right()) / vx
+                        : vx < 0 ? (grid_x(col_lo) - rect.left()) / vx
+                                 : inf;
+        float leave_x = vx > 0   ? (grid_x(col_lo + 1) - rect.left()) / vx
+                        : vx < 0 ? (grid_x(col_hi) - rect.right()) / vx
+                                 : inf;
+        float enter_y = vy > 0   ? (grid_y(row_hi + 1) - rect.top()) / vy
+                        : vy < 0 ? (grid_y(row_lo) - rect.bottom()) / vy
+                                 : inf;
+        float leave_y = vy > 0   ? (grid_y(row_lo + 1) - rect.bottom()) / vy
+                        : vy < 0 ? (grid_y(row_hi) - rect.top()) / vy
+                                 : inf;
+
+        float enter = std::min(enter_x, enter_y);
+        if (std::min(leave_x, leave_y) < enter)
+        {
+            if (leave_x <= leave_y)
+                vx > 0 ? ++col_lo : --col_hi;
+            else
+                vy > 0 ? ++row_lo : --row_hi;
+            continue;
+        }
+
+        if (enter > t_end || (first >= 0 && enter > first))
+            break;
+
+        if (enter_x <= enter_y)
+        {
+            int col = vx > 0 ? ++col_hi : --col_lo;
+            test_range(col, col, row_lo, row_hi);
+        }
+        else
+        {
+            int row = vy > 0 ? ++row_hi : --row_lo;
+            test_range(col_lo, col_hi, row, row);
+        }
+    }
+
+    return first;
+}
+
+TileCollisionMap::Contact TileCollisionMap::move(Rect &rect, const Vec2 &motion) const
+{
+    Contact contact;
+    bool blocked = false;
+
+    float dx = move_axis_x(rect, motion.get_x(), blocked);
+    if (blocked)
+        (motion.get_x() > 0 ? contact.right : contact.left) = true;
+    rect.set_x(rect.get_x() + dx);
+
+    blocked = false;
+    float dy = move_axis_y(rect, motion.get_y(), blocked);
+    if (blocked)
+        (motion.get_y() > 0 ? contact.floor : contact.ceiling) = true;
+    rect.set_y(rect.get_y() + dy);
+
+    return contact;
+}
+
+/**
+ * @brief 沿 x 轴按运动方向逐列检查, 遇到第一列阻挡格子就停下。
+ * 只检查与矩形在 y 方向上真正重叠的行; 起始时已重叠的列不阻挡, 交给穿透修正。
+ */
+float TileCollisionMap::move_axis_x(const Rect &rect, float dx, bool &blocked) const
+{
+    if (dx == 0)
+        return 0;
+
+    int row_begin = std::max(row_of(rect.bottom() + SKIN), 0);
+    int row_end = std::min(row_of(rect.top() - SKIN), m_rows - 1);
+
+    auto is_blocked = [&](int col)
+    {
+        for (int row = row_begin; row <= row_end; ++row)
+            if (m_tiles[row * m_cols + col] == TileType::Solid)
+                return true;
+        return false;
+    };
+
+    if (dx > 0)
+    {
+        int col_end = std::min(col_of(rect.right() + dx), m_cols - 1);
+        for (int col = std::max(col_of(rect.right() - SKIN), 0); col <= col_end; ++col)
+        {
+            float edge = m_origin.get_x() + col * m_cell_size;
+            if (edge >= rect.right() - SKIN && is_blocked(col))
+                return blocked = true, std::max(std::min(dx, edge - rect.right()), 0.0f);
+        }
+    }
+    else
+    {
+        int col_end = std::max(col_of(rect.left() + dx), 0);
+        for (int col = std::min(col_of(rect.left() + SKIN), m_cols - 1); col >= col_end; --col)
+        {
+            float edge = m_origin.get_x() + (col + 1) * m_cell_size;
+            if (edge <= rect.left() + SKIN && is_blocked(col))
+                return blocked = true, std::min(std::max(dx, edge - rect.left()), 0.0f);
+        }
+    }
+
+    return dx;
+}
+
+/**
+ * @brief 与 move_axis_x 相同, 但沿 +y 移动时单向平台也会阻挡。
+ */
+float TileCollisionMap::move_axis_y(const Rect &rect, float dy, bool &blocked) const
+{
+    if (dy == 0)
+        return 0;
+
+    int col_begin = std::max(col_of(rect.left() + SKIN), 0);
+    int col_end = std::min(col_of(rect.right() - SKIN), m_cols - 1);
+
+    auto is_blocked = [&](int row)
+    {
+        for (int col = col_begin; col <= col_end; ++col)
+        {
+            TileType type = m_tiles[row * m_cols + col];
+            if (type == TileType::Solid || (type == TileType::OneWay && dy > 0))
+                return true;
+        }
+        return false;
+    };
+
+    if (dy > 0)
+    {
+        int row_end = std::min(row_of(rect.top() + dy), m_rows - 1);
+        for (int row = std::max(row_of(rect.top() - SKIN), 0); row <= row_end; ++row)
+        {
+            float edge = m_origin.get_y() + row * m_cell_size;
+            if (edge >= rect.top() - SKIN && is_blocked(row))
+                return blocked = true, std::max(std::min(dy, edge - rect.top()), 0.0f);
+        }
+    }
+    else
+    {
+        int row_end = std::max(row_of(rect.bottom() + dy), 0);
+        for (int row = std::min(row_of(rect.bottom() + SKIN), m_rows - 1); row >= row_end; --row)
+        {
+            float edge = m_origin.get_y() + (row + 1) * m_cell_size;
+            if (edge <= rect.bottom() + SKIN && is_blocked(row))
+                return blocked = true, std::min(std::max(dy, edge - rect.bottom()), 0.0f);
+        }
+    }
+
+    return dy;
+}
@@ -0,0 +1,104 @@
+#ifndef INCLUDE_TILE_COLLISION_MAP
+#define INCLUDE_TILE_COLLISION_MAP
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/transform/point.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+enum class TileType : std::uint8_t
+{
+    Empty,
+    Solid,
+    OneWay // 单向平台: 只阻挡沿 +y 方向 (重力方向) 落下、且起始时完全位于格子之上的物体
+};
+
+/*
+    关卡静态几何的稠密网格表示, 每个格子只占一个字节。
+    相比为每块砖创建一个 ObstacleObject, 不需要堆分配碰撞盒, 也不会进入四叉树;
+    查询时只遍历运动范围覆盖到的格子。网格之外视为空。
+*/
+class TileCollisionMap
+{
+public:
+    // 按轴移动时发生阻挡的方向, floor 表示沿 +y 移动时被挡住。
+    struct Contact
+    {
+        bool left = false;
+        bool right = false;
+        bool floor = false;
+        bool ceiling = false;
+    };
+
+private:
+    Point m_origin;
+    float m_cell_size;
+    int m_cols;
+    int m_rows;
+    std::vector<TileType> m_tiles;
+
+public:
+    TileCollisionMap(const Point &origin, float cell_size, int cols, int rows);
+
+public:
+    Point get_origin() const { return m_origin; }
+    float get_cell_size() const { return m_cell_size; }
+    int get_cols() const { return m_cols; }
+    int get_rows() const { return m_rows; }
+    Rect bound() const { return Rect(m_origin, Vec2(m_cols * m_cell_size, m_rows * m_cell_size)); }
+
+    TileType get_tile(int col, int row) const
+    {
+        if (col < 0 || row < 0 || col >= m_cols || row >= m_rows)
+            return TileType::Empty;
+        return m_tiles[row * m_cols + col];
+    }
+    void set_tile(int col, int row, TileType type);
+    void fill(int col, int row, int cols, int rows, TileType type);
+    void clear();
+
+    Rect cell_rect(int col, int row) const
+    {
+        return Rect(m_origin.get_x() + col * m_cell_size, m_origin.get_y() + row * m_cell_size, m_cell_size, m_cell_size);
+    }
+    int col_of(float x) const { return (int)std::floor((x - m_origin.get_x()) / m_cell_size); }
+    int row_of(float y) const { return (int)std::floor((y - m_origin.get_y()) / m_cell_size); }
+
+public:
+    // 矩形是否与任何实心格子重叠 (单向平台不算)。
+    bool is_intersect(const Rect &rect) const;
+
+    // 矩形以 velocity 运动 max_time 内与格子的最早碰撞时间, 没有则返回 -1。
+    // 起始时已接触的格子只有在朝其外表面运动时才计入 (返回 0), 否则贴地滑动时地面会挡住对墙的查询。
+    // hit_cell 不为空时写入被撞格子的矩形。
+    float time_to_collide(const Rect &rect, const Vec2 &velocity, float max_time, Rect *hit_cell = nullptr) const;
+
+    // 先沿 x 再沿 y 移动 rect, 贴住最近的阻挡格子的边缘, 适合角色这类不需要反弹的移动。
+    Contact move(Rect &rect, const Vec2 &motion) const;
+
+    // 对 range 覆盖到的每个非空格子调用 func(const Rect &cell, TileType)。
+    template <typename Func>
+    void for_each_tile(const Rect &range, Func &&func) const
+    {
+        int col_begin = std::max(col_of(range.left()), 0), col_end = std::min(col_of(range.right()), m_cols - 1);
+        int row_begin = std::max(row_of(range.bottom()), 0), row_end = std::min(row_of(range.top()), m_rows - 1);
+
+        for (int row = row_begin; row <= row_end; ++row)
+            for (int col = col_begin; col <= col_end; ++col)
+            {
+                TileType type = m_tiles[row * m_cols + col];
+                if (type != TileType::Empty)
+                    func(cell_rect(col, row), type);
+            }
+    }
+
+private:
+    float move_axis_x(const Rect &rect, float dx, bool &blocked) const;
+    float move_axis_y(const Rect &rect, float dy, bool &blocked) const;
+};
+
+#endif // INCLUDE_TILE_COLLISION_MAP
@@ -0,0 +1,95 @@
+#include <echo_strike/core/thread_pool.hpp>
+
+#include <algorithm>
+#include <utility>
+
+ThreadPool::ThreadPool(size_t worker_count)
+{
+    workers.reserve(worker_count);
+    for (size_t i = 0; i < worker_count; ++i)
+        workers.emplace_back([this]()
+                             { work_loop(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(mtx);
+        stopping = true;
+    }
+    task_cv.notify_all();
+
+    for (auto &worker : workers)
+        worker.join();
+}
+
+void ThreadPool::submit(Task &&task)
+{
+    {
+        std::lock_guard lock(mtx);
+        tasks.push(std::move(task));
+        ++pending;
+    }
+    task_cv.notify_one();
+}
+
+void ThreadPool::wait()
+{
+    std::unique_lock lock(mtx);
+    done_cv.wait(lock, [this]()
+                 { return pending == 0; });
+}
+
+/**
+ * @brief 将 [0, count) 均分为至多 chunk_count() 块并行处理, 返回时所有块都已完成。
+ * 第 0 块在调用线程上执行, 分块方式只取决于 count 与线程数, 因此同一配置下结果可复现。
+ */
+void ThreadPool::parallel_for(size_t count, const RangeTask &func)
+{
+    if (count == 0)
+        return;
+
+    size_t chunks = std::min(count, chunk_count());
+    size_t chunk_size = (count + chunks - 1) / chunks;
+
+    for (size_t chunk = 1; chunk < chunks; ++chunk)
+    {
+        size_t begin = chunk * chunk_size;
+        size_t end = std::min(count, begin + chunk_size);
+        if (begin >= end)
+            break;
+
+        submit([&func, begin, end, chunk]()
+               { func(begin, end, chunk); });
+    }
+
+    func(0, std::min(count, chunk_size), 0);
+    wait();
+}
+
+void ThreadPool::work_loop()
+{
+    while (true)
+    {
+        Task task;
+        {
+            std::unique_lock lock(mtx);
+            task_cv.wait(lock, [this]()
+                         { return stopping || !tasks.empty(); });
+
+            if (stopping && tasks.empty())
+                return;
+
+            task = std::move(tasks.front());
+            tasks.pop();
+        }
+
+        task();
+
+        {
+            std::lock_guard lock(mtx);
+            --pending;
+        }
+        done_cv.notify_all();
+    }
+}
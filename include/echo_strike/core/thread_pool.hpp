@@ -0,0 +1,55 @@
+#ifndef INCLUDE_THREAD_POOL
+#define INCLUDE_THREAD_POOL
+
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+    // (begin, end, chunk): 处理 [begin, end) 区间, chunk 为分块序号, 可用于索引每块独立的缓冲区。
+    using RangeTask = std::function<void(size_t, size_t, size_t)>;
+
+private:
+    std::vector<std::thread> workers;
+    std::queue<Task> tasks;
+
+    std::mutex mtx;
+    std::condition_variable task_cv;
+    std::condition_variable done_cv;
+
+    size_t pending = 0;
+    bool stopping = false;
+
+public:
+    explicit ThreadPool(size_t worker_count = std::thread::hardware_concurrency());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ThreadPool(ThreadPool &&) noexcept = delete;
+    ThreadPool &operator=(ThreadPool &&) noexcept = delete;
+
+public:
+    size_t size() const { return workers.size(); }
+
+    // 参与 parallel_for 的分块数: 工作线程加上调用线程自身。
+    size_t chunk_count() const { return workers.size() + 1; }
+
+    void submit(Task &&);
+    void wait();
+
+    void parallel_for(size_t count, const RangeTask &func);
+
+private:
+    void work_loop();
+};
+
+#endif // INCLUDE_THREAD_POOL
@@ -0,0 +1,43 @@
+#include <echo_strike/core/world.hpp>
+
+#include <echo_strike/event/event_bus.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/entity/entity_manager.hpp>
+
+World &World::instance()
+{
+    static World world(Rect(0, 0, 800, 600), &EventBus::instance(), false);
+    return world;
+}
+
+World::World(const Rect &bound)
+    : World(bound, new EventBus(), true)
+{
+}
+
+World::World(const Rect &bound, EventBus *events, bool owns_events)
+    : m_events(events),
+      m_owns_events(owns_events),
+      m_collision(new CollisionManager(*this, bound)),
+      m_physics(new PhysicsManager(*this, bound)),
+      m_entities(new EntityManager(*this))
+{
+}
+
+World::~World()
+{
+    // 实体与物理对象持有碰撞盒, 必须先于碰撞管理器销毁。
+    m_entities.reset();
+    m_physics.reset();
+    m_collision.reset();
+    if (m_owns_events)
+        delete m_events;
+}
+
+void World::on_update(float ms)
+{
+    m_entities->on_update(ms);
+    m_physics->on_frame(ms / 1000.0f);
+    m_collision->process_collide();
+}
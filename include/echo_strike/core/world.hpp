@@ -0,0 +1,55 @@
+#ifndef INCLUDE_WORLD
+#define INCLUDE_WORLD
+
+#include <echo_strike/transform/rect.hpp>
+
+#include <memory>
+
+class CollisionManager;
+class PhysicsManager;
+class EntityManager;
+class EventBus;
+
+/*
+    一个独立的模拟世界: 拥有自己的碰撞索引、物理对象、实体和事件总线。
+    不同 World 之间没有共享状态, 可以分别在不同线程上推进 (例如服务器上的多场对局或 AI 预演)。
+    各管理器的 instance() 返回的是默认世界 World::instance() 中的对应对象;
+    默认世界的事件发布到 EventBus::instance(), 显式创建的世界各自拥有一条总线。
+*/
+class World
+{
+public:
+    static World &instance();
+
+private:
+    EventBus *m_events;
+    bool m_owns_events;
+    std::unique_ptr<CollisionManager> m_collision;
+    std::unique_ptr<PhysicsManager> m_physics;
+    std::unique_ptr<EntityManager> m_entities;
+
+private:
+    World(const Rect &bound, EventBus *events, bool owns_events);
+
+public:
+    World(const Rect &bound = Rect(0, 0, 800, 600));
+    ~World();
+
+    World(const World &) = delete;
+    World &operator=(const World &) = delete;
+
+    World(World &&) noexcept = delete;
+    World &operator=(World &&) noexcept = delete;
+
+public:
+    // ms 为毫秒, 与 Entity::on_update 一致; 物理部分按秒推进, 开启固定步长后由累积器决定步数。
+    void on_update(float ms);
+
+public:
+    EventBus &events() { return *m_events; }
+    CollisionManager &collision() { return *m_collision; }
+    PhysicsManager &physics() { return *m_physics; }
+    EntityManager &entities() { return *m_entities; }
+};
+
+#endif // INCLUDE_WORLD
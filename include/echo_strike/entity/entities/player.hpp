@@ -18,7 +18,10 @@ private:
     const float SPEED_ROLL = 800.0f;
 
 public:
-    Player()
+    Player() : Player(World::instance()) {}
+
+    explicit Player(World &world)
+        : Entity(world)
     {
         auto &manager = ResourceManager::instance();
         auto renderer = DeviceManager::instance().get_renderer();
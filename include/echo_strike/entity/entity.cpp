@@ -1,5 +1,6 @@
 #include <echo_strike/entity/entity.hpp>
 
+#include <echo_strike/core/world.hpp>
 #include <echo_strike/collision/collision_manager.hpp>
 
 #include <echo_strike/config/config_manager.hpp>
@@ -8,16 +9,22 @@
 #include <pjh_json/helpers/json_ref.hpp>
 
 Entity::Entity()
+    : Entity(World::instance())
 {
-    m_hit_box = CollisionManager::instance().create_collision_box();
+}
+
+Entity::Entity(World &world)
+    : m_world(&world)
+{
+    m_hit_box = m_world->collision().create_collision_box();
     m_hit_box->set_enable(false);
-    m_hurt_box = CollisionManager::instance().create_collision_box();
+    m_hurt_box = m_world->collision().create_collision_box();
 }
 
 Entity::~Entity()
 {
-    CollisionManager::instance().destroy_collision_box(m_hit_box);
-    CollisionManager::instance().destroy_collision_box(m_hurt_box);
+    m_world->collision().destroy_collision_box(m_hit_box);
+    m_world->collision().destroy_collision_box(m_hurt_box);
 }
 
 void Entity::on_update(float ms)
@@ -27,14 +34,22 @@ void Entity::on_update(float ms)
     else
         m_is_moving = false;
 
+    Rect prev_rect = m_rect;
     Object::on_update(ms);
 
-    if (m_rect.top() >= m_boundary.top())
-        m_is_on_floor = true;
-    else if (m_speed.get_y() >= 0)
-        m_is_falling = true;
-    else
-        m_is_jumping = true;
+    // 把这一帧的位移交给角色控制器, 扫掠到障碍物和网格上, 被挡住的方向速度清零。
+    Vec2 motion = m_rect.get_position() - prev_rect.get_position();
+    m_rect.set_position(prev_rect.get_position());
+
+    auto contact = m_controller.move(m_world->collision(), m_rect, motion, m_is_on_floor);
+    if (contact.left || contact.right)
+        m_speed.set_x(0);
+    if (contact.floor || contact.ceiling)
+        m_speed.set_y(0);
+
+    m_is_on_floor = (m_type == MotionType::LimitedInBoundary && m_rect.top() >= m_boundary.top()) || contact.floor;
+    m_is_falling = !m_is_on_floor && m_speed.get_y() >= 0;
+    m_is_jumping = !m_is_on_floor && m_speed.get_y() < 0;
 
     anim_sm.on_update(ms);
 }
@@ -83,13 +98,13 @@ void Entity::load_animations(const std::string &key)
 void Entity::set_hit_box(CollisionBox *box)
 {
     if (m_hit_box)
-        CollisionManager::instance().destroy_collision_box(m_hit_box);
+        m_world->collision().destroy_collision_box(m_hit_box);
     m_hit_box = box;
 }
 
 void Entity::set_hurt_box(CollisionBox *box)
 {
     if (m_hurt_box)
-        CollisionManager::instance().destroy_collision_box(m_hurt_box);
+        m_world->collision().destroy_collision_box(m_hurt_box);
     m_hurt_box = box;
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <echo_strike/utils/class_marcos.hpp>
 
 #include <echo_strike/physics/object.hpp>
+#include <echo_strike/physics/character_controller.hpp>
 
 #include <echo_strike/entity/status.hpp>
 #include <echo_strike/entity/entity_state.hpp>
@@ -14,18 +15,24 @@
 
 class CollisionBox;
 class EntityManager;
+class World;
 
 class Entity : public Object
 {
     friend class EntityManager;
 
 protected:
+    World *m_world;
+
     Status stus;
     StateMachine anim_sm;
 
     CollisionBox *m_hit_box;
     CollisionBox *m_hurt_box;
 
+    // 每帧的位移交给它扫掠到障碍物和网格上, 角色不进入刚体求解。
+    CharacterController m_controller;
+
 protected:
     bool m_is_on_floor = false;
     bool m_is_falling = false;
@@ -35,6 +42,7 @@ protected:
 
 protected:
     Entity();
+    explicit Entity(World &);
 
 public:
     virtual ~Entity();
@@ -70,12 +78,17 @@ public:
     virtual const StateMachine &get_state_machine() const { return anim_sm; }
 
 public:
+    World *get_world() const { return m_world; }
+
     CollisionBox *get_hit_box() const { return m_hit_box; }
     void set_hit_box(CollisionBox *);
 
     CollisionBox *get_hurt_box() const { return m_hurt_box; }
     void set_hurt_box(CollisionBox *);
 
+    CharacterController &get_character_controller() { return m_controller; }
+    const CharacterController &get_character_controller() const { return m_controller; }
+
 public:
     bool is_on_floor() const { return m_is_on_floor; }
     bool is_falling() const { return m_is_falling; }
@@ -6,22 +6,29 @@
 
 #include <echo_strike/device/renderer.hpp>
 
+#include <echo_strike/core/world.hpp>
+
 #include <vector>
 
 class Entity;
 
 class EntityManager
 {
+    friend class World;
+
 public:
-    static EntityManager &instance()
-    {
-        static EntityManager manager;
-        return manager;
-    }
+    static EntityManager &instance() { return World::instance().entities(); }
+
     template <typename T>
     T *create_entity()
     {
-        auto t = new T();
+        // 支持以 World & 构造的实体会被放进本管理器所属的世界。
+        T *t;
+        if constexpr (requires { new T(*m_world); })
+            t = new T(*m_world);
+        else
+            t = new T();
+
         if (auto ptr = static_cast<Entity *>(t))
         {
             ets.push_back(ptr);
@@ -48,11 +55,14 @@ public:
     }
 
 private:
+    World *m_world;
     Rect bound;
     std::vector<Entity *> ets;
 
 private:
-    EntityManager() = default;
+    EntityManager(World &world) : m_world(&world) {}
+
+public:
     ~EntityManager() = default;
 
 public:
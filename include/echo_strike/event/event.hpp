@@ -18,6 +18,7 @@ public:
         MouseReleased,
         MouseMove,
         Collision,
+        CollisionBatch,
         None
     };
 
@@ -30,6 +30,9 @@ public:
     }
 
 private:
+    // 除了默认总线, 只有显式创建的 World 会拥有一条自己的总线。
+    friend class World;
+
     EventBus() = default;
     ~EventBus() = default;
 
@@ -4,10 +4,12 @@
 #include <echo_strike/event/event.hpp>
 #include <echo_strike/physics/object.hpp>
 #include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/collision/collision_contact.hpp>
 
 #include <SDL3/SDL_scancode.h>
 #include <SDL3/SDL_mouse.h>
 
+#include <span>
 #include <tuple>
 
 class KeyPressedEvent : public Event
@@ -125,4 +127,22 @@ public:
     std::tuple<Object *, Object *> get_objects() const { return {obj1, obj2}; }
 };
 
+// 一帧内所有接触的批量事件, 由 CollisionManager 每帧发布一次。
+// contacts 指向管理器内部的缓冲区, 只在订阅回调执行期间有效, 需要保留请自行拷贝。
+class CollisionBatchEvent : public Event
+{
+private:
+    std::span<const CollisionContact> contacts;
+
+public:
+    CollisionBatchEvent(std::span<const CollisionContact> c = {})
+        : Event(EventType::CollisionBatch),
+          contacts(c) {}
+    ~CollisionBatchEvent() override = default;
+
+public:
+    std::span<const CollisionContact> get_contacts() const { return contacts; }
+    void set_contacts(std::span<const CollisionContact> c) { contacts = c; }
+};
+
 #endif // INCLUDE_EVENTS
\ No newline at end of file
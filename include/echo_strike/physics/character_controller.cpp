@@ -0,0 +1,167 @@
+#include <echo_strike/physics/character_controller.hpp>
+
+#include <echo_strike/collision/collision_box.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+// 容差: 恰好贴在表面上的矩形不算重叠, 与 TileCollisionMap 一致。
+static constexpr float SKIN = 1e-3f;
+
+// 移动后向下探测地面的距离, 静止站立 (本帧没有向下的位移) 时也能判定为站在地面上。
+static constexpr float GROUND_PROBE = 0.01f;
+
+/**
+ * @brief 站在地面上时检查向下的吸附距离; 水平被挡住、且有台阶高度时, 抬高后再试一次水平移动。
+ * 网格的单向平台按 TileCollisionMap::move 的规则处理: 只在下落时阻挡。
+ */
+CharacterController::Contact CharacterController::move(CollisionManager &collision, Rect &rect, const Vec2 &motion, bool on_floor)
+{
+    Contact contact;
+
+    float probe = on_floor ? std::max(m_snap_distance, GROUND_PROBE) : GROUND_PROBE;
+    Rect range = Rect::bounding_box({rect, rect + motion});
+    gather(collision, Rect(range.get_x() - SKIN, range.get_y() - m_step_height - SKIN,
+                           range.get_width() + SKIN * 2, range.get_height() + m_step_height + probe + SKIN * 2));
+
+    bool blocked = false;
+    float dx = motion.get_x();
+    float moved = sweep_x(collision, rect, dx, blocked);
+    rect.set_x(rect.get_x() + moved);
+    if (blocked)
+    {
+        if (on_floor && m_step_height > 0 && try_step_up(collision, rect, dx, moved))
+            contact.stepped = true;
+        else
+            (dx > 0 ? contact.right : contact.left) = true;
+    }
+
+    blocked = false;
+    float dy = motion.get_y();
+    rect.set_y(rect.get_y() + sweep_y(collision, rect, dy, blocked));
+    if (blocked)
+        (dy > 0 ? contact.floor : contact.ceiling) = true;
+
+    if (!contact.floor && dy >= 0)
+    {
+        bool landed = false;
+        float down = sweep_y(collision, rect, probe, landed);
+        if (landed)
+        {
+            contact.floor = true;
+            if (down > SKIN)
+            {
+                rect.set_y(rect.get_y() + down);
+                contact.snapped = true;
+            }
+        }
+    }
+
+    return contact;
+}
+
+/**
+ * @brief 从静态索引中取出范围内会阻挡角色的障碍物, 一次移动只查询一次。
+ */
+void CharacterController::gather(CollisionManager &collision, const Rect &range)
+{
+    m_candidates.clear();
+    m_obstacles.clear();
+    collision.static_tree().query(range, m_candidates);
+    for (auto box : m_candidates)
+        if (box->get_enable() && (layer_mask(box->get_src()) & m_collision_mask))
+            m_obstacles.push_back(box->get_rect());
+}
+
+/**
+ * @brief 只考虑与矩形在 y 方向上真正重叠的障碍物; 起始时已重叠的不阻挡, 否则角色会被卡在里面。
+ */
+float CharacterController::sweep_x(const CollisionManager &collision, const Rect &rect, float dx, bool &blocked) const
+{
+    if (dx == 0)
+        return 0;
+
+    float allowed = dx;
+    if (auto *tiles = collision.tile_map())
+    {
+        Rect moved = rect;
+        auto contact = tiles->move(moved, Vec2(dx, 0));
+        allowed = moved.get_x() - rect.get_x();
+        blocked = contact.left || contact.right;
+    }
+
+    for (const auto &box : m_obstacles)
+    {
+        if (box.top() <= rect.bottom() + SKIN || box.bottom() >= rect.top() - SKIN)
+            continue;
+
+        float gap = dx > 0 ? box.left() - rect.right() : box.right() - rect.left();
+        if (dx > 0 ? (gap < -SKIN || gap > allowed) : (gap > SKIN || gap < allowed))
+            continue;
+
+        allowed = dx > 0 ? std::max(gap, 0.0f) : std::min(gap, 0.0f);
+        blocked = true;
+    }
+    return allowed;
+}
+
+/**
+ * @brief 与 sweep_x 相同, 沿 y 方向。
+ */
+float CharacterController::sweep_y(const CollisionManager &collision, const Rect &rect, float dy, bool &blocked) const
+{
+    if (dy == 0)
+        return 0;
+
+    float allowed = dy;
+    if (auto *tiles = collision.tile_map())
+    {
+        Rect moved = rect;
+        auto contact = tiles->move(moved, Vec2(0, dy));
+        allowed = moved.get_y() - rect.get_y();
+        blocked = contact.floor || contact.ceiling;
+    }
+
+    for (const auto &box : m_obstacles)
+    {
+        if (box.right() <= rect.left() + SKIN || box.left() >= rect.right() - SKIN)
+            continue;
+
+        float gap = dy > 0 ? box.bottom() - rect.top() : box.top() - rect.bottom();
+        if (dy > 0 ? (gap < -SKIN || gap > allowed) : (gap > SKIN || gap < allowed))
+            continue;
+
+        allowed = dy > 0 ? std::max(gap, 0.0f) : std::min(gap, 0.0f);
+        blocked = true;
+    }
+    return allowed;
+}
+
+/**
+ * @brief 从被挡住的位置抬高至多 step_height, 平移剩下的水平位移, 再落回抬高的高度。
+ * 只有平移确实前进了、并且落下时踩到了台阶顶面才采用, 否则 rect 保持不变。
+ */
+bool CharacterController::try_step_up(const CollisionManager &collision, Rect &rect, float dx, float moved) const
+{
+    Rect raised = rect;
+    bool blocked = false;
+    float up = sweep_y(collision, raised, -m_step_height, blocked);
+    if (up > -SKIN)
+        return false;
+    raised.set_y(raised.get_y() + up);
+
+    blocked = false;
+    float across = sweep_x(collision, raised, dx - moved, blocked);
+    if (std::abs(across) <= SKIN)
+        return false;
+    raised.set_x(raised.get_x() + across);
+
+    bool landed = false;
+    raised.set_y(raised.get_y() + sweep_y(collision, raised, -up, landed));
+    if (!landed)
+        return false;
+
+    rect = raised;
+    return true;
+}
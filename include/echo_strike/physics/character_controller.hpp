@@ -0,0 +1,65 @@
+#ifndef INCLUDE_CHARACTER_CONTROLLER
+#define INCLUDE_CHARACTER_CONTROLLER
+
+#include <echo_strike/utils/class_marcos.hpp>
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/collision/collision_layer.hpp>
+
+#include <vector>
+
+class CollisionBox;
+class CollisionManager;
+
+/*
+    运动学角色控制器: 把角色一帧的位移按轴扫掠到静态索引中的障碍物和网格上, 贴住最近的阻挡面并沿其余方向滑动。
+    只读取静态几何, 角色不创建刚体、不进入物理步进, 也不会被动态物体推动。
+    - 台阶: 水平方向被不高于 step_height 的障碍挡住、且角色站在地面上时, 先抬高再平移再落下, 直接走上去;
+    - 贴地: 站在地面上向下走台阶 (或走过不高于 snap_distance 的落差) 时向下吸附, 不会变成腾空状态。
+    几何都是轴对齐的, 斜坡由阶梯状的格子表示, 靠这两项走得平滑。
+*/
+class CharacterController
+{
+public:
+    // 本次移动中发生阻挡的方向, floor 表示最终站在地面上 (被向下挡住或吸附到了地面)。
+    struct Contact
+    {
+        bool left = false;
+        bool right = false;
+        bool floor = false;
+        bool ceiling = false;
+        bool stepped = false; // 走上了台阶
+        bool snapped = false; // 向下吸附到了地面
+    };
+
+private:
+    std::vector<CollisionBox *> m_candidates;
+    std::vector<Rect> m_obstacles; // 本次移动范围内参与阻挡的障碍物矩形
+
+    CLASS_PROPERTY(float, step_height)
+    CLASS_PROPERTY(float, snap_distance)
+    CLASS_PROPERTY(CollisionLayerMask, collision_mask) // 会阻挡角色的障碍物所在的层
+
+public:
+    CharacterController()
+        : m_step_height(0),
+          m_snap_distance(0),
+          m_collision_mask(layer_mask(CollisionLayer::Obstacle))
+    {
+    }
+
+public:
+    // 先沿 x 再沿 y 移动 rect; on_floor 为移动前是否站在地面上, 决定能否走台阶和向下吸附。
+    Contact move(CollisionManager &, Rect &rect, const Vec2 &motion, bool on_floor);
+
+private:
+    void gather(CollisionManager &, const Rect &range);
+
+    // 沿单轴移动, 返回实际移动的距离; 与网格和障碍物中更近的一方贴合。
+    float sweep_x(const CollisionManager &, const Rect &rect, float dx, bool &blocked) const;
+    float sweep_y(const CollisionManager &, const Rect &rect, float dy, bool &blocked) const;
+
+    bool try_step_up(const CollisionManager &, Rect &rect, float dx, float moved) const;
+};
+
+#endif // INCLUDE_CHARACTER_CONTROLLER
@@ -0,0 +1,265 @@
+#include <echo_strike/physics/contact_solver.hpp>
+#include <echo_strike/physics/rigid_body_store.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+static constexpr float k_slop = 0.01f;   // 允许的微小重叠，防止抖动
+// 每次迭代修正的比例。修正过猛时, 速度迭代次数较少的高堆叠会在两者之间来回振荡。
+static constexpr float k_percent = 0.5f;
+
+/**
+ * @brief 两个矩形的面接触: 法线取重叠量最小 (或间隙最小) 的轴, 从 b 指向 a, 与碰撞响应一致。
+ * 另一轴上必须有重叠, 只是角对角靠近的物体不算接触。
+ */
+static bool face_contact(const Rect &a, const Rect &b, Vec2 &normal, float &separation)
+{
+    Vec2 n = a.center() - b.center();
+    float overlap_x = (a.get_width() + b.get_width()) * 0.5f - std::abs(n.get_x());
+    float overlap_y = (a.get_height() + b.get_height()) * 0.5f - std::abs(n.get_y());
+
+    if (overlap_x < overlap_y)
+    {
+        if (overlap_y <= 0)
+            return false;
+        normal = Vec2(n.get_x() > 0 ? 1.0f : -1.0f, 0);
+        separation = -overlap_x;
+    }
+    else
+    {
+        if (overlap_x <= 0)
+            return false;
+        normal = Vec2(0, n.get_y() > 0 ? 1.0f : -1.0f);
+        separation = -overlap_y;
+    }
+    return true;
+}
+
+/**
+ * @brief 投机接触的法线: 至少一个轴上已重叠时法线没有歧义, 与 face_contact 相同;
+ * 两个轴上都有间隙时取按本步相对位移 motion 最后才闭合的轴, 斜着撞向墙角的物体也能得到正确的面。
+ * 有间隙的轴在本步内不会闭合 (正在远离或位移不够) 时两者不会接触。
+ */
+bool ContactSolver::swept_face_contact(const Rect &a, const Vec2 &motion, const Rect &b, Vec2 &normal, float &separation)
+{
+    Vec2 n = a.center() - b.center();
+    float overlap_x = (a.get_width() + b.get_width()) * 0.5f - std::abs(n.get_x());
+    float overlap_y = (a.get_height() + b.get_height()) * 0.5f - std::abs(n.get_y());
+    if (overlap_x > 0 || overlap_y > 0)
+        return face_contact(a, b, normal, separation);
+
+    // 闭合该轴间隙所需的时间占本步的比例, 不会闭合时为 2
+    auto entry = [](float overlap, float offset, float move)
+    { return move * offset >= 0 ? 2.0f : -overlap / std::abs(move); };
+    float tx = entry(overlap_x, n.get_x(), motion.get_x());
+    float ty = entry(overlap_y, n.get_y(), motion.get_y());
+    if (std::max(tx, ty) > 1)
+        return false;
+
+    if (tx > ty)
+    {
+        normal = Vec2(n.get_x() > 0 ? 1.0f : -1.0f, 0);
+        separation = -overlap_x;
+    }
+    else
+    {
+        normal = Vec2(0, n.get_y() > 0 ? 1.0f : -1.0f);
+        separation = -overlap_y;
+    }
+    return true;
+}
+
+static bool is_box_pair(const ContactSolver::Contact &contact)
+{
+    return contact.shape_a == ShapeType::Rect && contact.shape_b == ShapeType::Rect;
+}
+
+// 沿给定的轴向法线计算间距, 不要求另一轴重叠。
+static float separation_along(const Rect &a, const Rect &b, const Vec2 &normal)
+{
+    Vec2 n = a.center() - b.center();
+    return normal.get_x() != 0 ? n.get_x() * normal.get_x() - (a.get_width() + b.get_width()) * 0.5f
+                               : n.get_y() * normal.get_y() - (a.get_height() + b.get_height()) * 0.5f;
+}
+
+void ContactSolver::begin()
+{
+    m_previous.swap(m_contacts);
+    m_contacts.clear();
+}
+
+void ContactSolver::add(size_t a, size_t b, const Rect &wall, std::pair<size_t, size_t> key, float restitution,
+                        ShapeType shape_a, ShapeType shape_b)
+{
+    Contact contact{};
+    contact.a = a;
+    contact.b = b;
+    contact.wall = wall;
+    contact.key = key;
+    contact.restitution = restitution;
+    contact.shape_a = shape_a;
+    contact.shape_b = shape_b;
+    m_contacts.push_back(contact);
+}
+
+void ContactSolver::add(size_t a, const Rect &wall, const Vec2 &normal, std::pair<size_t, size_t> key, float restitution)
+{
+    add(a, NO_BODY, wall, key, restitution);
+    m_contacts.back().normal = normal;
+    m_contacts.back().fixed_normal = true;
+}
+
+/**
+ * @brief 按 key 排序后逐个计算接触参数。排序让求解顺序只取决于碰撞盒 id, 与收集顺序无关,
+ * 也让上一步的接触可以二分查找。
+ * 间距为正 (尚未真正接触) 的慢速接触允许在本步内恰好合上间隙, 不会在半空中停住;
+ * 提前按恢复系数反弹则会把本步的重力加速也一并弹回, 物体永远弹不低。
+ */
+void ContactSolver::prepare(RigidBodyStore &store, float dt, float restitution_threshold, bool speculative)
+{
+    auto by_key = [](const Contact &lhs, const Contact &rhs)
+    { return lhs.key < rhs.key; };
+    std::sort(m_contacts.begin(), m_contacts.end(), by_key);
+
+    const float *vx = store.m_vx.data(), *vy = store.m_vy.data();
+    const float *inv_mass = store.m_inv_mass.data();
+
+    size_t count = 0;
+    for (auto &contact : m_contacts)
+    {
+        size_t a = contact.a, b = contact.b;
+        Rect rect_a = store.rect(a), rect_b = b == NO_BODY ? contact.wall : store.rect(b);
+        Vec2 motion = (store.speed(a) - (b == NO_BODY ? Vec2() : store.speed(b))) * dt;
+        if (contact.fixed_normal)
+            contact.separation = separation_along(rect_a, rect_b, contact.normal);
+        else if (!is_box_pair(contact))
+            shape_contact(contact.shape_a, rect_a, contact.shape_b, rect_b, contact.normal, contact.separation);
+        else if (speculative ? !swept_face_contact(rect_a, motion, rect_b, contact.normal, contact.separation)
+                             : !face_contact(rect_a, rect_b, contact.normal, contact.separation))
+            continue;
+
+        float im_b = b == NO_BODY ? 0.0f : inv_mass[b];
+        float total_inv_mass = inv_mass[a] + im_b;
+        if (total_inv_mass < 1e-6f)
+            continue; // 如果两个物体都不可移动
+
+        contact.normal_mass = 1 / total_inv_mass;
+
+        float rvx = vx[a] - (b == NO_BODY ? 0.0f : vx[b]);
+        float rvy = vy[a] - (b == NO_BODY ? 0.0f : vy[b]);
+        float vn = rvx * contact.normal.get_x() + rvy * contact.normal.get_y();
+        if (-vn <= restitution_threshold)
+            contact.target = -std::max(contact.separation, 0.0f) / dt;
+        else if (contact.separation <= k_slop)
+            contact.target = -contact.restitution * vn;
+        else if (speculative)
+            contact.target = -contact.separation / dt; // 恰好在步末合上间隙, 下一步接触时再反弹
+        else
+            continue; // 快速接近但还有间隙: 交给连续碰撞检测在真正接触的时刻反弹
+
+        // 同一对物体上一步沿同一法线的累积冲量; 圆形的法线每步略有转动, 按夹角而不是逐位比较
+        contact.impulse = 0;
+        auto it = std::lower_bound(m_previous.begin(), m_previous.end(), contact, by_key);
+        if (it != m_previous.end() && it->key == contact.key && it->normal.dot(contact.normal) > 0.99f)
+            contact.impulse = it->impulse;
+
+        m_contacts[count++] = contact;
+    }
+    m_contacts.resize(count);
+
+    float *wvx = store.m_vx.data(), *wvy = store.m_vy.data();
+    for (auto &contact : m_contacts)
+    {
+        float px = contact.normal.get_x() * contact.impulse, py = contact.normal.get_y() * contact.impulse;
+        wvx[contact.a] += px * inv_mass[contact.a], wvy[contact.a] += py * inv_mass[contact.a];
+        if (contact.b != NO_BODY)
+            wvx[contact.b] -= px * inv_mass[contact.b], wvy[contact.b] -= py * inv_mass[contact.b];
+    }
+}
+
+/**
+ * @brief 逐个接触施加冲量, 使法向相对速度趋向 target。
+ * 限制的是累积冲量而不是单次增量: 单次增量可以为负, 抵消前几轮 (或热启动) 推得过多的部分。
+ */
+void ContactSolver::solve_velocities(RigidBodyStore &store, int iterations)
+{
+    float *vx = store.m_vx.data(), *vy = store.m_vy.data();
+    const float *inv_mass = store.m_inv_mass.data();
+
+    for (int i = 0; i < iterations; ++i)
+        for (auto &contact : m_contacts)
+        {
+            size_t a = contact.a, b = contact.b;
+            float nx = contact.normal.get_x(), ny = contact.normal.get_y();
+
+            float rvx = vx[a] - (b == NO_BODY ? 0.0f : vx[b]);
+            float rvy = vy[a] - (b == NO_BODY ? 0.0f : vy[b]);
+            float vn = rvx * nx + rvy * ny;
+
+            float lambda = -contact.normal_mass * (vn - contact.target);
+            float impulse = std::max(contact.impulse + lambda, 0.0f);
+            lambda = impulse - contact.impulse;
+            contact.impulse = impulse;
+
+            vx[a] += nx * lambda * inv_mass[a], vy[a] += ny * lambda * inv_mass[a];
+            if (b != NO_BODY)
+                vx[b] -= nx * lambda * inv_mass[b], vy[b] -= ny * lambda * inv_mass[b];
+        }
+}
+
+/**
+ * @brief 物体移动后按当前位置重新计算每个接触沿法线的重叠, 按逆质量比例把两者推开。
+ * 矩形对的法线沿用 prepare 时的方向; 含圆或胶囊体的一对随位置重新计算最近点。都不重新查询四叉树。
+ */
+int ContactSolver::solve_positions(RigidBodyStore &store, int iterations)
+{
+    float *x = store.m_x.data(), *y = store.m_y.data();
+    const float *w = store.m_w.data(), *h = store.m_h.data();
+    const float *inv_mass = store.m_inv_mass.data();
+
+    int i = 0;
+    while (i < iterations)
+    {
+        ++i;
+        bool moved = false;
+        for (auto &contact : m_contacts)
+        {
+            size_t a = contact.a, b = contact.b;
+            float nx = contact.normal.get_x(), ny = contact.normal.get_y();
+
+            float bx, by, bw, bh;
+            if (b == NO_BODY)
+                bx = contact.wall.get_x(), by = contact.wall.get_y(), bw = contact.wall.get_width(), bh = contact.wall.get_height();
+            else
+                bx = x[b], by = y[b], bw = w[b], bh = h[b];
+
+            float separation, lateral = 1;
+            if (is_box_pair(contact))
+            {
+                // 法线只有一个轴不为零
+                float dx = (x[a] + w[a] * 0.5f) - (bx + bw * 0.5f), dy = (y[a] + h[a] * 0.5f) - (by + bh * 0.5f);
+                separation = nx != 0 ? dx * nx - (w[a] + bw) * 0.5f : dy * ny - (h[a] + bh) * 0.5f;
+                // 另一轴上已经错开 (例如滑出了平台边缘) 时不再推开
+                lateral = nx != 0 ? (h[a] + bh) * 0.5f - std::abs(dy) : (w[a] + bw) * 0.5f - std::abs(dx);
+            }
+            else
+            {
+                Vec2 normal;
+                shape_contact(contact.shape_a, Rect(x[a], y[a], w[a], h[a]), contact.shape_b, Rect(bx, by, bw, bh),
+                              normal, separation);
+                nx = normal.get_x(), ny = normal.get_y();
+            }
+            if (separation >= -k_slop || lateral <= 0)
+                continue;
+
+            float correction = -(separation + k_slop) * k_percent * contact.normal_mass;
+            x[a] += nx * correction * inv_mass[a], y[a] += ny * correction * inv_mass[a];
+            if (b != NO_BODY)
+                x[b] -= nx * correction * inv_mass[b], y[b] -= ny * correction * inv_mass[b];
+            moved = true;
+        }
+        if (!moved)
+            break;
+    }
+    return i;
+}
@@ -0,0 +1,76 @@
+#ifndef INCLUDE_CONTACT_SOLVER
+#define INCLUDE_CONTACT_SOLVER
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/collision/collision_shape.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+class RigidBodyStore;
+
+/*
+    顺序冲量接触求解器。
+    每步开始时收集一次处于接触 (或在容差内重叠) 的物体对, 之后只在这份列表上迭代, 不再查询四叉树:
+    速度迭代对每个接触施加法向冲量, 累积冲量限制为非负 (只推不拉);
+    位置迭代在物体移动后按接触法线把重叠量分摊给两个物体。
+    上一步同一对物体的累积冲量用来热启动, 静止的堆叠物体每步只需要很少的迭代就能收敛。
+    两者都是矩形时法线只沿坐标轴; 含圆或胶囊体的一对按形状的最近点计算法线和间距 (shape_contact)。
+    投机接触模式下还会收到本步内可能相遇、但尚有间隙的物体对: 把接近速度限制为恰好在步末合上间隙,
+    代替连续碰撞检测防止穿透。
+*/
+class ContactSolver
+{
+public:
+    static constexpr size_t NO_BODY = static_cast<size_t>(-1);
+
+    struct Contact
+    {
+        size_t a;  // 动态物体在 RigidBodyStore 中的下标
+        size_t b;  // 另一个动态物体的下标, 障碍物为 NO_BODY
+        Rect wall; // b 为障碍物时它的矩形
+
+        std::pair<size_t, size_t> key; // 两者碰撞盒 id, 用于排序和跨步匹配
+        float restitution;
+        ShapeType shape_a; // 碰撞盒形状, 固定法线的网格接触只用包围盒
+        ShapeType shape_b;
+
+        Vec2 normal;       // 从 b 指向 a
+        bool fixed_normal; // 法线由调用者给定 (网格格子之间的接缝不能产生法线), prepare 不重新选择
+        float separation;  // 沿法线的间距, 负数表示重叠
+        float normal_mass; // 1 / (a 与 b 的逆质量之和)
+        float target;      // 求解后希望达到的法向相对速度
+        float impulse;     // 本步累积的法向冲量
+    };
+
+private:
+    std::vector<Contact> m_contacts;
+    std::vector<Contact> m_previous; // 上一步的接触, 按 key 排序
+
+public:
+    // 开始收集新一步的接触, 当前的接触留作热启动的依据。
+    void begin();
+    void add(size_t a, size_t b, const Rect &wall, std::pair<size_t, size_t> key, float restitution,
+             ShapeType shape_a = ShapeType::Rect, ShapeType shape_b = ShapeType::Rect);
+    void add(size_t a, const Rect &wall, const Vec2 &normal, std::pair<size_t, size_t> key, float restitution);
+
+    // 计算法线和有效质量, 丢弃不再接触的物体对, 并施加热启动冲量。
+    // 接近速度超过 restitution_threshold 的接触按恢复系数反弹, 否则视为静止接触。
+    // speculative 为 true 时法线按本步的相对运动选择, 快速接近但尚有间隙的接触限制为步末恰好接触。
+    void prepare(RigidBodyStore &store, float dt, float restitution_threshold, bool speculative = false);
+
+    void solve_velocities(RigidBodyStore &store, int iterations);
+    // 返回实际执行的迭代次数, 没有需要修正的重叠时提前结束。
+    int solve_positions(RigidBodyStore &store, int iterations);
+
+    // 投机接触的法线与间距: motion 为 a 相对 b 本步的位移, 本步内不会相遇时返回 false。
+    static bool swept_face_contact(const Rect &a, const Vec2 &motion, const Rect &b, Vec2 &normal, float &separation);
+
+    const std::vector<Contact> &contacts() const { return m_contacts; }
+    // 恢复快照时使用: 替换当前的接触列表, 下一步用它热启动。下标必须对应恢复后的物体排列。
+    void set_contacts(const std::vector<Contact> &contacts) { m_contacts = contacts; }
+};
+
+#endif // INCLUDE_CONTACT_SOLVER
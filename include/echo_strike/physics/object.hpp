@@ -9,8 +9,17 @@
 #include <echo_strike/physics/movement_controller.hpp>
 
 #include <SDL3/SDL.h>
+#include <cstdint>
 #include <iostream>
 
+// 物体种类标签。物理循环按它 switch 派发, 代替逐个尝试 dynamic_cast。
+enum class BodyKind : std::uint8_t
+{
+    None,
+    Physical,
+    Obstacle
+};
+
 class Object
 {
 public:
@@ -26,16 +35,28 @@ protected:
     MovementController move_ctrl;
 
     float m_mass = 1.0;
+    BodyKind m_body_kind = BodyKind::None;
 
-    CLASS_PROPERTY(Rect, rect)
-    CLASS_PROPERTY(Vec2, speed)
-    CLASS_PROPERTY(Vec2, force)
+    Rect m_rect;
+    Vec2 m_speed;
+    Vec2 m_force;
     CLASS_PROPERTY(Rect, boundary)
 
 public:
     Object() = default;
     virtual ~Object() = default;
 
+public:
+    // 虚函数: PhysicalObject 的状态保存在 RigidBodyStore 中, 经由 Object 指针 (碰撞盒、事件、实体状态) 读写的也是那一份。
+    virtual Rect get_rect() const { return m_rect; }
+    virtual void set_rect(const Rect &rect) { m_rect = rect; }
+
+    virtual Vec2 get_speed() const { return m_speed; }
+    virtual void set_speed(const Vec2 &speed) { m_speed = speed; }
+
+    virtual Vec2 get_force() const { return m_force; }
+    virtual void set_force(const Vec2 &force) { m_force = force; }
+
 public:
     virtual void add_speed(const Vec2 &speed) { m_speed += speed; }
     virtual void add_force(const Vec2 &force) { m_force += force; }
@@ -90,6 +111,8 @@ public:
     }
 
 public:
+    BodyKind get_body_kind() const { return m_body_kind; }
+
     float get_mass() const { return m_mass; }
     void set_mass(float m) { m_mass = m; }
 
@@ -103,4 +126,11 @@ public:
     void set_move_direction(const Vec2 &dir) { move_dir = dir; }
 };
 
+// 按种类标签向下转换, 标签不符时返回空; T 需要提供 static constexpr BodyKind KIND。
+template <typename T>
+T *body_cast(Object *obj)
+{
+    return obj && obj->get_body_kind() == T::KIND ? static_cast<T *>(obj) : nullptr;
+}
+
 #endif // INCLUDE_OBJECT
\ No newline at end of file
@@ -2,34 +2,50 @@
 #define INCLUDE_OBSTACLE_OBJECT
 
 #include <echo_strike/physics/object.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
 
 #include <echo_strike/collision/collision_layer.hpp>
 #include <echo_strike/collision/collision_box.hpp>
 #include <echo_strike/collision/collision_manager.hpp>
 
+#include <echo_strike/core/world.hpp>
+
 class ObstacleObject : public Object
 {
 private:
     CollisionBox &box;
 
 public:
-    ObstacleObject()
-        : box(*CollisionManager::instance().create_collision_box())
+    static constexpr BodyKind KIND = BodyKind::Obstacle;
+
+public:
+    ObstacleObject() : ObstacleObject(World::instance()) {}
+
+    explicit ObstacleObject(World &world)
+        : box(*world.collision().create_collision_box(true))
     {
+        m_body_kind = KIND;
         box.set_object(this);
         box.set_src(CollisionLayer::Obstacle);
     }
 
+    // 放在障碍物上休眠的物体需要在障碍物移走后醒来, 否则会悬在半空。
     ~ObstacleObject()
     {
-        CollisionManager::instance().destroy_collision_box(&box);
+        box.get_world()->physics().wake_in(box.get_rect());
+        box.get_world()->collision().destroy_collision_box(&box);
     }
 
 public:
-    void set_rect(const Rect &rect)
+    CollisionBox &collision_box() { return box; }
+    const CollisionBox &collision_box() const { return box; }
+
+    void set_rect(const Rect &rect) override
     {
+        box.get_world()->physics().wake_in(box.get_rect());
         box.set_rect(rect);
         Object::set_rect(rect);
+        box.get_world()->physics().wake_in(rect);
     }
 };
 
@@ -0,0 +1,350 @@
+#include <echo_strike/physics/particle_system.hpp>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/collision/collision_box.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/collision/tile_collision_map.hpp>
+
+#include <SDL3/SDL.h>
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define PARTICLE_SYSTEM_SSE2
+#include <emmintrin.h>
+#endif
+
+static uint32_t pack_color(const Color &color)
+{
+    auto channel = [](int value)
+    { return static_cast<uint32_t>(std::clamp(value, 0, 255)); };
+    return channel(color.R) << 24 | channel(color.G) << 16 | channel(color.B) << 8 | channel(color.A);
+}
+
+ParticleSystem::ParticleSystem(World &world, size_t capacity)
+    : m_world(&world),
+      m_capacity(capacity),
+      m_rng(std::random_device{}()),
+      m_gravity(0, 0),
+      m_drag(0),
+      m_collision(ParticleCollision::None),
+      m_collision_mask(layer_mask(CollisionLayer::Obstacle)),
+      m_restitution(0.3f),
+      m_particle_size(2),
+      m_fade_out(true)
+{
+}
+
+ParticleSystem::~ParticleSystem() = default;
+
+ParticleEmitter *ParticleSystem::create_emitter()
+{
+    m_emitters.push_back(std::make_unique<ParticleEmitter>());
+    return m_emitters.back().get();
+}
+
+void ParticleSystem::destroy_emitter(ParticleEmitter *emitter)
+{
+    std::erase_if(m_emitters, [&](const std::unique_ptr<ParticleEmitter> &ptr)
+                  { return ptr.get() == emitter; });
+}
+
+void ParticleSystem::clear()
+{
+    for (auto *field : {&m_x, &m_y, &m_vx, &m_vy, &m_life, &m_inv_life})
+        field->clear();
+    m_color.clear();
+}
+
+void ParticleSystem::set_capacity(size_t capacity)
+{
+    m_capacity = capacity;
+    if (size() <= capacity)
+        return;
+
+    // 保留最早生成的粒子
+    for (auto *field : {&m_x, &m_y, &m_vx, &m_vy, &m_life, &m_inv_life})
+        field->resize(capacity);
+    m_color.resize(capacity);
+}
+
+Color ParticleSystem::color(size_t index) const
+{
+    uint32_t c = m_color[index];
+    return Color(c >> 24 & 0xff, c >> 16 & 0xff, c >> 8 & 0xff, c & 0xff);
+}
+
+void ParticleSystem::emit(const ParticleEmitter &emitter, size_t count)
+{
+    count = std::min(count, m_capacity - std::min(size(), m_capacity));
+    for (size_t i = 0; i < count; ++i)
+        spawn(emitter);
+}
+
+void ParticleSystem::spawn(const ParticleEmitter &emitter)
+{
+    std::uniform_real_distribution<float> unit(0, 1), signed_unit(-1, 1);
+    const Rect &area = emitter.area;
+    float life = emitter.min_life + (emitter.max_life - emitter.min_life) * unit(m_rng);
+    life = std::max(life, 1e-3f);
+
+    m_x.push_back(area.get_x() + area.get_width() * unit(m_rng));
+    m_y.push_back(area.get_y() + area.get_height() * unit(m_rng));
+    m_vx.push_back(emitter.velocity.get_x() + emitter.velocity_spread.get_x() * signed_unit(m_rng));
+    m_vy.push_back(emitter.velocity.get_y() + emitter.velocity_spread.get_y() * signed_unit(m_rng));
+    m_life.push_back(life);
+    m_inv_life.push_back(1 / life);
+    m_color.push_back(pack_color(emitter.color));
+}
+
+/**
+ * @brief 发射、积分、碰撞、删除, 每一步各遍历一次数组。
+ * 碰撞只在开启时进行, 并且只对数组做一次顺序遍历; 粒子从不进入四叉树。
+ */
+void ParticleSystem::on_update(float delta)
+{
+    if (delta <= 0)
+        return;
+
+    for (auto &emitter : m_emitters)
+    {
+        if (!emitter->enable)
+            continue;
+        emitter->pending += emitter->rate * delta;
+        auto count = static_cast<size_t>(emitter->pending);
+        emitter->pending -= static_cast<float>(count);
+        emit(*emitter, count);
+    }
+
+    integrate(0, size(), delta);
+
+    if (m_collision != ParticleCollision::None)
+    {
+        if (m_world->collision().tile_map())
+            collide_tiles(delta);
+        if (m_collision == ParticleCollision::Static)
+            collide_static(delta);
+    }
+
+    remove_dead();
+}
+
+/**
+ * @brief 速度按阻力衰减并加上重力, 再按新速度移动 (半隐式欧拉, 与 RigidBodyStore 一致), 寿命减去 dt。
+ * SSE2 路径与标量尾部使用相同的运算顺序。
+ */
+void ParticleSystem::integrate(size_t begin, size_t end, float dt)
+{
+    float *x = m_x.data(), *y = m_y.data();
+    float *vx = m_vx.data(), *vy = m_vy.data();
+    float *life = m_life.data();
+
+    float damping = std::max(1 - m_drag * dt, 0.0f);
+    float gx = m_gravity.get_x() * dt, gy = m_gravity.get_y() * dt;
+
+    size_t i = begin;
+
+#ifdef PARTICLE_SYSTEM_SSE2
+    const __m128 step = _mm_set1_ps(dt), damp = _mm_set1_ps(damping);
+    const __m128 dvx = _mm_set1_ps(gx), dvy = _mm_set1_ps(gy);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 sx = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vx + i), damp), dvx);
+        __m128 sy = _mm_add_ps(_mm_mul_ps(_mm_loadu_ps(vy + i), damp), dvy);
+        _mm_storeu_ps(vx + i, sx), _mm_storeu_ps(vy + i, sy);
+        _mm_storeu_ps(x + i, _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(sx, step)));
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(sy, step)));
+        _mm_storeu_ps(life + i, _mm_sub_ps(_mm_loadu_ps(life + i), step));
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        vx[i] = vx[i] * damping + gx;
+        vy[i] = vy[i] * damping + gy;
+        x[i] = x[i] + vx[i] * dt;
+        y[i] = y[i] + vy[i] * dt;
+        life[i] = life[i] - dt;
+    }
+}
+
+/**
+ * @brief 粒子按点处理, 先沿 x 再沿 y 逐格检查本步经过的格子, 遇到阻挡就退回原位并按恢复系数反弹。
+ * 仍在上一步所在的格子里的粒子 (绝大多数) 不需要任何检查; 单向平台只挡住从上方落下的粒子。
+ */
+void ParticleSystem::collide_tiles(float dt)
+{
+    const auto &tiles = *m_world->collision().tile_map();
+
+    for (size_t i = 0, n = size(); i < n; ++i)
+    {
+        float prev_x = m_x[i] - m_vx[i] * dt, prev_y = m_y[i] - m_vy[i] * dt;
+        int col0 = tiles.col_of(prev_x), row0 = tiles.row_of(prev_y);
+        int col1 = tiles.col_of(m_x[i]), row1 = tiles.row_of(m_y[i]);
+        if (col0 == col1 && row0 == row1)
+            continue;
+
+        for (int step = col1 > col0 ? 1 : -1, col = col0; col != col1;)
+            if (tiles.get_tile(col += step, row0) == TileType::Solid)
+            {
+                m_x[i] = prev_x, m_vx[i] = -m_vx[i] * m_restitution;
+                col1 = col0;
+                break;
+            }
+
+        for (int step = row1 > row0 ? 1 : -1, row = row0; row != row1;)
+        {
+            TileType type = tiles.get_tile(col1, row += step);
+            if (type == TileType::Solid || (type == TileType::OneWay && step > 0))
+            {
+                m_y[i] = prev_y, m_vy[i] = -m_vy[i] * m_restitution;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 从静态索引中取出粒子范围内的障碍物, 分到粗粒度的均匀网格里, 每个粒子只检查所在网格中的几个矩形。
+ * 障碍物之外的动态物体不参与, 粒子不会被它们挡住。
+ */
+void ParticleSystem::collide_static(float dt)
+{
+    if (size() == 0)
+        return;
+
+    float min_x = m_x[0], max_x = m_x[0], min_y = m_y[0], max_y = m_y[0];
+    for (size_t i = 1, n = size(); i < n; ++i)
+    {
+        min_x = std::min(min_x, m_x[i]), max_x = std::max(max_x, m_x[i]);
+        min_y = std::min(min_y, m_y[i]), max_y = std::max(max_y, m_y[i]);
+    }
+
+    m_candidates.clear();
+    m_world->collision().static_tree().query(Rect(min_x, min_y, max_x - min_x + 1, max_y - min_y + 1), m_candidates);
+    std::erase_if(m_candidates, [&](CollisionBox *box)
+                  { return !box->get_enable() || !(layer_mask(box->get_src()) & m_collision_mask); });
+    if (m_candidates.empty())
+        return;
+
+    // 每格约 64 像素, 每个方向至多 64 格
+    constexpr int max_bins = 64;
+    float bin_w = std::max((max_x - min_x + 1) / max_bins, 64.0f);
+    float bin_h = std::max((max_y - min_y + 1) / max_bins, 64.0f);
+    int cols = std::min(static_cast<int>((max_x - min_x) / bin_w) + 1, max_bins);
+    int rows = std::min(static_cast<int>((max_y - min_y) / bin_h) + 1, max_bins);
+    auto col_of = [&](float x)
+    { return std::clamp(static_cast<int>((x - min_x) / bin_w), 0, cols - 1); };
+    auto row_of = [&](float y)
+    { return std::clamp(static_cast<int>((y - min_y) / bin_h), 0, rows - 1); };
+
+    // 按格子计数后排成一个数组 (计数排序), 不为每个格子单独分配
+    auto for_each_bin = [&](const Rect &rect, auto &&func)
+    {
+        for (int row = row_of(rect.bottom()); row <= row_of(rect.top()); ++row)
+            for (int col = col_of(rect.left()); col <= col_of(rect.right()); ++col)
+                func(row * cols + col);
+    };
+
+    m_bin_start.assign(cols * rows + 1, 0);
+    for (auto box : m_candidates)
+        for_each_bin(box->get_rect(), [&](int bin)
+                     { ++m_bin_start[bin + 1]; });
+    for (size_t b = 1; b < m_bin_start.size(); ++b)
+        m_bin_start[b] += m_bin_start[b - 1];
+
+    m_bin_cursor.assign(m_bin_start.begin(), m_bin_start.end() - 1);
+    m_bin_rects.resize(m_bin_start.back());
+    for (auto box : m_candidates)
+        for_each_bin(box->get_rect(), [&](int bin)
+                     { m_bin_rects[m_bin_cursor[bin]++] = box->get_rect(); });
+
+    for (size_t i = 0, n = size(); i < n; ++i)
+    {
+        float x = m_x[i], y = m_y[i];
+        int bin = row_of(y) * cols + col_of(x);
+        for (int k = m_bin_start[bin]; k < m_bin_start[bin + 1]; ++k)
+        {
+            const Rect &rect = m_bin_rects[k];
+            if (x <= rect.left() || x >= rect.right() || y <= rect.bottom() || y >= rect.top())
+                continue;
+
+            // 从哪一侧进入: 上一步在 x 范围之外则是左右两侧, 否则是上下两侧
+            float prev_x = x - m_vx[i] * dt, prev_y = y - m_vy[i] * dt;
+            if (prev_x <= rect.left() || prev_x >= rect.right())
+                m_x[i] = prev_x, m_vx[i] = -m_vx[i] * m_restitution;
+            else if (prev_y <= rect.bottom() || prev_y >= rect.top())
+                m_y[i] = prev_y, m_vy[i] = -m_vy[i] * m_restitution;
+            break;
+        }
+    }
+}
+
+/**
+ * @brief 把存活的粒子依次前移, 保持生成顺序, 一次遍历完成。
+ */
+void ParticleSystem::remove_dead()
+{
+    size_t kept = 0;
+    for (size_t i = 0, n = size(); i < n; ++i)
+    {
+        if (m_life[i] <= 0)
+            continue;
+        if (kept != i)
+        {
+            m_x[kept] = m_x[i], m_y[kept] = m_y[i];
+            m_vx[kept] = m_vx[i], m_vy[kept] = m_vy[i];
+            m_life[kept] = m_life[i], m_inv_life[kept] = m_inv_life[i];
+            m_color[kept] = m_color[i];
+        }
+        ++kept;
+    }
+
+    for (auto *field : {&m_x, &m_y, &m_vx, &m_vy, &m_life, &m_inv_life})
+        field->resize(kept);
+    m_color.resize(kept);
+}
+
+/**
+ * @brief 所有粒子拼成一批三角形, 一次 SDL_RenderGeometry 画完, 而不是每个粒子一次绘制调用。
+ */
+void ParticleSystem::render(SDL_Renderer *renderer)
+{
+    size_t n = size();
+    if (n == 0)
+        return;
+
+    m_vertices.resize(n * 4);
+    if (m_indices.size() < n * 6)
+    {
+        size_t begin = m_indices.size() / 6;
+        m_indices.resize(n * 6);
+        for (size_t i = begin; i < n; ++i)
+        {
+            int v = static_cast<int>(i * 4);
+            int *out = &m_indices[i * 6];
+            out[0] = v, out[1] = v + 1, out[2] = v + 2;
+            out[3] = v + 2, out[4] = v + 3, out[5] = v;
+        }
+    }
+
+    float half = m_particle_size * 0.5f;
+    for (size_t i = 0; i < n; ++i)
+    {
+        uint32_t c = m_color[i];
+        float alpha = (c & 0xff) / 255.0f;
+        if (m_fade_out)
+            alpha *= std::clamp(m_life[i] * m_inv_life[i], 0.0f, 1.0f);
+        SDL_FColor color{(c >> 24) / 255.0f, (c >> 16 & 0xff) / 255.0f, (c >> 8 & 0xff) / 255.0f, alpha};
+
+        float x = m_x[i], y = m_y[i];
+        SDL_Vertex *v = &m_vertices[i * 4];
+        v[0] = {{x - half, y - half}, color, {0, 0}};
+        v[1] = {{x + half, y - half}, color, {1, 0}};
+        v[2] = {{x + half, y + half}, color, {1, 1}};
+        v[3] = {{x - half, y + half}, color, {0, 1}};
+    }
+
+    SDL_RenderGeometry(renderer, nullptr, m_vertices.data(), static_cast<int>(n * 4), m_indices.data(), static_cast<int>(n * 6));
+}
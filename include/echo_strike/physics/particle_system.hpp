@@ -0,0 +1,125 @@
+#ifndef INCLUDE_PARTICLE_SYSTEM
+#define INCLUDE_PARTICLE_SYSTEM
+
+#include <echo_strike/utils/class_marcos.hpp>
+#include <echo_strike/utils/color.hpp>
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/collision/collision_layer.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+class CollisionBox;
+class World;
+
+struct SDL_Renderer;
+struct SDL_Vertex;
+
+// 粒子发射器: 每秒在 area 内随机位置生成 rate 个粒子。纯数据, 由 ParticleSystem 持有并在 on_update 中读取。
+struct ParticleEmitter
+{
+    Rect area;
+    float rate = 0;
+    Vec2 velocity;
+    Vec2 velocity_spread; // 初速度的每个分量在 ±spread 内随机
+    float min_life = 1;   // 寿命 (秒) 在 [min_life, max_life] 内随机
+    float max_life = 1;
+    Color color = Color(255, 255, 255, 255);
+    bool enable = true;
+
+    float pending = 0; // 不足一个粒子的累积, 保证低发射率下的平均速率正确
+};
+
+// 粒子与关卡几何的碰撞。都只做一步一次的点检测, 不进入动态宽阶段; 一步走过整个障碍物的粒子会穿过去。
+enum class ParticleCollision
+{
+    None,
+    Tiles, // 只与网格的实心格子碰撞, 每个粒子查一个格子
+    Static // 网格以及静态索引中的障碍物
+};
+
+/*
+    只用于视觉效果的粒子。与 PhysicalObject 不同, 粒子没有对象、碰撞盒或回调,
+    位置、速度、剩余寿命和颜色按字段存放在连续数组中 (SoA), 积分一次处理 4 个粒子 (SSE2)。
+    粒子之间不碰撞, 也不影响任何物体; 死亡的粒子在每步末尾被压实掉, 其余粒子保持生成顺序。
+    数量达到 capacity 后新的粒子直接丢弃。
+*/
+class ParticleSystem
+{
+private:
+    World *m_world;
+    size_t m_capacity;
+
+    std::vector<float> m_x, m_y;
+    std::vector<float> m_vx, m_vy;
+    std::vector<float> m_life;     // 剩余寿命, 不大于 0 时死亡
+    std::vector<float> m_inv_life; // 初始寿命的倒数, 用于按剩余比例淡出
+    std::vector<uint32_t> m_color; // RGBA, 每个通道 8 位
+
+    std::vector<std::unique_ptr<ParticleEmitter>> m_emitters;
+    std::mt19937 m_rng;
+
+    // Static 模式下每步重建的障碍物分桶: 第 b 格的矩形为 m_bin_rects[m_bin_start[b], m_bin_start[b + 1])
+    std::vector<CollisionBox *> m_candidates;
+    std::vector<int> m_bin_start, m_bin_cursor;
+    std::vector<Rect> m_bin_rects;
+    std::vector<SDL_Vertex> m_vertices;
+    std::vector<int> m_indices;
+
+    CLASS_PROPERTY(Vec2, gravity)
+    CLASS_PROPERTY(float, drag) // 每秒损失的速度比例
+    CLASS_PROPERTY(ParticleCollision, collision)
+    CLASS_PROPERTY(CollisionLayerMask, collision_mask) // Static 模式下会阻挡粒子的障碍物所在的层
+    CLASS_PROPERTY(float, restitution)                 // 碰撞后法向速度保留的比例
+    CLASS_PROPERTY(float, particle_size)               // 渲染时的边长
+    CLASS_PROPERTY(bool, fade_out)                     // 渲染时按剩余寿命比例降低不透明度
+
+public:
+    explicit ParticleSystem(World &world, size_t capacity = 100000);
+    ~ParticleSystem();
+
+    ParticleSystem(const ParticleSystem &) = delete;
+    ParticleSystem &operator=(const ParticleSystem &) = delete;
+
+public:
+    ParticleEmitter *create_emitter();
+    void destroy_emitter(ParticleEmitter *);
+
+    // 按 emitter 的参数立即生成 count 个粒子, emitter 不必属于这个系统。
+    void emit(const ParticleEmitter &, size_t count);
+
+    // 推进 delta 秒: 发射器生成新粒子, 积分, 与几何碰撞, 删除死亡的粒子。
+    void on_update(float delta);
+
+    void render(SDL_Renderer *);
+
+    void clear();
+    void seed(uint32_t seed) { m_rng.seed(seed); }
+
+public:
+    size_t size() const { return m_x.size(); }
+    size_t capacity() const { return m_capacity; }
+    void set_capacity(size_t capacity);
+
+    Vec2 position(size_t index) const { return Vec2(m_x[index], m_y[index]); }
+    Vec2 velocity(size_t index) const { return Vec2(m_vx[index], m_vy[index]); }
+    float life(size_t index) const { return m_life[index]; }
+    Color color(size_t index) const;
+
+    const std::vector<std::unique_ptr<ParticleEmitter>> &emitters() const { return m_emitters; }
+
+private:
+    void spawn(const ParticleEmitter &);
+
+    // 对 [begin, end) 中的粒子积分, 与 RigidBodyStore 一样按 4 个一组向量化。
+    void integrate(size_t begin, size_t end, float dt);
+    void collide_tiles(float dt);
+    void collide_static(float dt);
+    void remove_dead();
+};
+
+#endif // INCLUDE_PARTICLE_SYSTEM
@@ -1,167 +1,170 @@
 #include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
 
 // ====================================================================================
 // 段落 1: 构造函数 / 析构函数
 // ====================================================================================
 
-PhysicalObject::PhysicalObject()
-    : box(*CollisionManager::instance().create_collision_box()),
-      Object()
+PhysicalObject::PhysicalObject(World &world)
+    : Object(),
+      box(*world.collision().create_collision_box()),
+      m_physics(world.physics()),
+      m_store(m_physics.bodies()),
+      m_handle(m_store.create(this))
 {
+    m_body_kind = KIND;
+    m_store.set_mass(m_handle, m_mass);
+    m_physics.attach(this);
     box.set_object(this);
     box.set_src(CollisionLayer::Physics);
     box.add_dst(CollisionLayer::Physics);
     box.add_dst(CollisionLayer::Obstacle);
 
-    // 这个回调函数现在专门用于“碰撞响应”（改变速度）。
-    // 它只会在我们将物体移动到精确的碰撞时刻后才被触发。
-    box.on_collide(
-        [this](CollisionBox &other)
-        {
-            if (auto wall = dynamic_cast<ObstacleObject *>(other.get_object()))
-                handle_collision_response(*wall);
-            else if (auto other_obj = dynamic_cast<PhysicalObject *>(other.get_object()))
-                handle_collision_response(*other_obj);
-        });
+    // 碰撞响应 (改变速度) 只由 PhysicsManager 的接触求解器和连续碰撞检测完成, 碰撞盒不设置回调;
+    // 否则 World::on_update 在物理步进之后调用 process_collide 时, 接触中的物体会再受到一次求解器之外的冲量。
+    // 游戏逻辑仍然可以通过 collision_box().on_collide 注册自己的回调。
 }
 
 PhysicalObject::~PhysicalObject()
 {
-    CollisionManager::instance().destroy_collision_box(&box);
+    m_physics.detach(this);
+    box.get_world()->collision().destroy_collision_box(&box);
+    m_store.destroy(m_handle);
 }
 
-void PhysicalObject::advance_state(float time_step)
+void PhysicalObject::set_rect(const Rect &rect)
 {
-    Object::on_update(time_step);
-    box.set_rect(m_rect);
+    if (rect != get_rect())
+        wake_up();
+    move_rect(rect);
+    m_prev_rect = rect;
 }
 
-/**
- * @brief 查找第一个将要碰撞的物体以及碰撞时间 (Time of Impact, TOI)。
- * @param max_time 查找碰撞的最大时间范围 (例如，当前帧的剩余时间)。
- * @return 一个包含{碰撞时间, 指向被撞物体的碰撞盒指针}的 pair。
- */
-std::pair<float, CollisionBox *> PhysicalObject::find_first_collision(float max_time)
+void PhysicalObject::set_speed(const Vec2 &speed)
 {
-    // 宽阶段 (Broad Phase): 创建一个能包围物体整个运动轨迹的包围盒 (AABB)。
-    Rect origin_rect = m_rect;
-    Vec2 current_speed = get_speed();
-
-    Rect future_rect = origin_rect;
-    future_rect.set_x(future_rect.get_x() + current_speed.get_x() * max_time);
-    future_rect.set_y(future_rect.get_y() + current_speed.get_y() * max_time);
-
-    // 运动包围盒 (motion_aabb) 应该包含起点和终点两个矩形。
-    auto motion_aabb = Rect::bounding_box({origin_rect, future_rect});
-
-    box.set_rect(motion_aabb);
-    auto potential_collisions = box.process_collide();
-    box.set_rect(origin_rect); // 重要: 探测完毕后，将碰撞盒恢复到物体的实际当前位置。
-
-    // 窄阶段 (Narrow Phase): 在所有潜在的碰撞对象中，精确计算出最早的碰撞时间。
-    CollisionBox *first_collided_box = nullptr;
-    float first_collided_time = max_time + 1e-6f; // 初始化为一个比最大时间稍大的值
-
-    for (auto other_box : potential_collisions)
-    {
-        float t = origin_rect.time_to_collide(current_speed, other_box->get_rect());
+    if (speed != get_speed())
+        wake_up();
+    m_store.set_speed(m_handle, speed);
+}
 
-        // 我们只关心未来的、并且比当前记录的还要早的碰撞。
-        // 使用一个极小值 (epsilon, 1e-6f) 来防止与刚刚分离的物体立即再次发生碰撞。
-        if (t > 1e-6f && t < first_collided_time)
-        {
-            first_collided_time = t;
-            first_collided_box = other_box;
-        }
-    }
+void PhysicalObject::set_force(const Vec2 &force)
+{
+    if (force != get_force())
+        wake_up();
+    m_store.set_force(m_handle, force);
+}
 
-    return {first_collided_time, first_collided_box};
+void PhysicalObject::wake_up()
+{
+    if (m_sleeping)
+        m_physics.wake_up(this);
 }
 
-void PhysicalObject::resolve_penetration_pair(ObstacleObject &wall)
+void PhysicalObject::move_rect(const Rect &rect)
 {
-    Rect box_rect = this->get_rect();
-    Rect wall_rect = wall.get_rect();
+    m_store.set_rect(m_handle, rect);
+    box.set_rect(rect);
+}
 
-    Vec2 n = box_rect.center() - wall_rect.center(); // 从墙指向物体的向量
+void PhysicalObject::set_mass(float mass)
+{
+    m_mass = mass;
+    m_store.set_mass(m_handle, mass);
+}
 
-    Vec2 half_size_obj = box_rect.get_size() * 0.5f;
-    Vec2 half_size_wall = wall_rect.get_size() * 0.5f;
-    float overlap_x = (half_size_obj.get_x() + half_size_wall.get_x()) - std::abs(n.get_x());
-    float overlap_y = (half_size_obj.get_y() + half_size_wall.get_y()) - std::abs(n.get_y());
+void PhysicalObject::set_boundary(const Rect &boundary)
+{
+    Object::set_boundary(boundary);
+    update_boundary();
+}
 
-    if (overlap_x <= 0 || overlap_y <= 0)
-        return;
+void PhysicalObject::set_motion_type(MotionType type)
+{
+    m_type = type;
+    update_boundary();
+}
 
-    Vec2 correction_normal;
-    float penetration_depth;
-    if (overlap_x < overlap_y)
-    {
-        penetration_depth = overlap_x;
-        // 法线方向应该与 n 的 x 分量同向，将物体推出
-        correction_normal = Vec2(n.get_x() > 0 ? 1.0f : -1.0f, 0);
-    }
+void PhysicalObject::update_boundary()
+{
+    if (m_type == MotionType::LimitedInBoundary)
+        m_store.set_boundary(m_handle, m_boundary);
     else
-    {
-        penetration_depth = overlap_y;
-        // 法线方向应该与 n 的 y 分量同向，将物体推出
-        correction_normal = Vec2(0, n.get_y() > 0 ? 1.0f : -1.0f);
-    }
-
-    const float k_slop = 0.01f; // 允许的微小重叠，防止抖动
-    const float percent = 1.0f; // 推开力量的百分比，防止弹射过猛
-    Vec2 correction = correction_normal * std::max(penetration_depth - k_slop, 0.0f) * percent;
-    // 直接将物体沿修正法线方向移出墙体
-    this->set_rect(box_rect + correction);
+        m_store.clear_boundary(m_handle);
 }
 
-void PhysicalObject::resolve_penetration_pair(PhysicalObject &other)
+Rect PhysicalObject::get_interpolated_rect(float alpha) const
 {
-    Rect box_rect = this->get_rect();
-    Rect other_box_rect = other.get_rect();
-
-    Vec2 n = other_box_rect.center() - box_rect.center(); // 从 this 指向 other 的向量
-
-    if (n.length() < 1e-6f)
-        n = Vec2(0, -1.0f); // 处理完美重叠的特殊情况
-
-    Vec2 half_size1 = box_rect.get_size() * 0.5f;
-    Vec2 half_size2 = other_box_rect.get_size() * 0.5f;
-    float overlap_x = (half_size1.get_x() + half_size2.get_x()) - std::abs(n.get_x());
-    float overlap_y = (half_size1.get_y() + half_size2.get_y()) - std::abs(n.get_y());
+    Rect rect = get_rect();
+    rect.set_position(m_prev_rect.get_position() + (rect.get_position() - m_prev_rect.get_position()) * alpha);
+    return rect;
+}
 
-    if (overlap_x <= 0 || overlap_y <= 0)
-        return;
+/**
+ * @brief 单独推进一个物体: 先按力更新速度, 再按速度移动, 积分由 RigidBodyStore 完成。
+ * 物体由速度和力驱动, 不使用 Object 的移动方向。
+ */
+void PhysicalObject::advance_state(float time_step)
+{
+    m_store.apply_forces(m_handle, m_handle + 1, time_step);
+    m_store.advance(m_handle, local_time() + time_step);
+    sync_box();
+}
 
-    Vec2 correction_normal;
-    float penetration_depth;
-    // 【关键修正】这里的法线方向必须正确，才能将物体推开而不是推入
-    if (overlap_x < overlap_y)
-    {
-        penetration_depth = overlap_x;
-        // 如果 n.x > 0 (other在this右边)，法线应该指向左边 (-1,0) 来推开 this
-        // 如果 n.x < 0 (other在this左边)，法线应该指向右边 (1,0) 来推开 this
-        correction_normal = Vec2(n.get_x() > 0 ? -1.0f : 1.0f, 0);
-    }
-    else
-    {
-        penetration_depth = overlap_y;
-        // 同理，修正y轴方向
-        correction_normal = Vec2(0, n.get_y() > 0 ? -1.0f : 1.0f);
-    }
+/**
+ * @brief 在网格中查找最早的碰撞。
+ * @param cell 输出被撞格子的矩形。
+ * @return 碰撞时间, 在 max_time 内没有碰撞时返回 -1。
+ */
+float PhysicalObject::find_first_tile_collision(const TileCollisionMap &tiles, float max_time, Rect &cell)
+{
+    return tiles.time_to_collide(get_rect(), get_speed(), max_time, &cell);
+}
 
+/**
+ * @brief 把物体从重叠的格子中推出, 返回是否做了修正。
+ * 相邻两个实心格子之间的内部边不能作为推出方向, 否则物体沿地面滑动时会在接缝处被横向推开;
+ * 单向平台只会把中心仍在平台上方的物体向上推出。
+ */
+bool PhysicalObject::resolve_penetration_tiles(const TileCollisionMap &tiles)
+{
     const float k_slop = 0.01f;
-    const float percent = 0.8f;
-    float total_inv_mass = (1.0f / m_mass) + (1.0f / other.m_mass);
-    if (total_inv_mass < 1e-6f)
-        return; // 如果两个物体都不可移动
+    bool found = false;
 
-    Vec2 correction = correction_normal * (std::max(penetration_depth - k_slop, 0.0f) / total_inv_mass) * percent;
+    tiles.for_each_tile(
+        get_rect(),
+        [&](const Rect &cell, TileType type)
+        {
+            Rect box_rect = this->get_rect();
+            Vec2 n = box_rect.center() - cell.center(); // 从格子指向物体的向量
+
+            float overlap_x = (box_rect.get_width() + cell.get_width()) * 0.5f - std::abs(n.get_x());
+            float overlap_y = (box_rect.get_height() + cell.get_height()) * 0.5f - std::abs(n.get_y());
+            if (overlap_x <= k_slop || overlap_y <= k_slop)
+                return;
+
+            int col = tiles.col_of(cell.center().get_x());
+            int row = tiles.row_of(cell.center().get_y());
+            int dir_x = n.get_x() > 0 ? 1 : -1;
+            int dir_y = n.get_y() > 0 ? 1 : -1;
+
+            bool open_x = type == TileType::Solid && tiles.get_tile(col + dir_x, row) != TileType::Solid;
+            bool open_y = tiles.get_tile(col, row + dir_y) != TileType::Solid;
+            if (type == TileType::OneWay)
+                open_y = open_y && box_rect.center().get_y() < cell.bottom();
+
+            Vec2 correction;
+            if (open_x && (!open_y || overlap_x < overlap_y))
+                correction = Vec2(dir_x * (overlap_x - k_slop), 0);
+            else if (open_y)
+                correction = Vec2(0, dir_y * (overlap_y - k_slop));
+            else
+                return;
+
+            this->move_rect(box_rect + correction);
+            found = true;
+        });
 
-    // 【关键修正】根据修正后的法线方向，正确地移动两个物体
-    // this 应该沿着法线方向移动，other 应该沿着反方向移动
-    this->set_rect(this->get_rect() + correction * (1.0f / m_mass));
-    other.set_rect(other.get_rect() - correction * (1.0f / other.m_mass));
+    return found;
 }
 
 // ====================================================================================
@@ -170,10 +173,21 @@ void PhysicalObject::resolve_penetration_pair(PhysicalObject &other)
 // ====================================================================================
 // ... [前面的代码都一样] ...
 
+// 法向速度低于 PhysicsManager 的 restitution_threshold 时视为静止接触, 不再反弹;
+// 否则停在地面上的物体每帧被重力加速后又被弹起, 永远达不到休眠所需的低速。
+float PhysicalObject::restitution_for(float vel_along_normal, float restitution) const
+{
+    return -vel_along_normal < m_physics.get_restitution_threshold() ? 0.0f : restitution;
+}
+
 void PhysicalObject::handle_collision_response(ObstacleObject &wall)
+{
+    handle_collision_response(wall.get_rect());
+}
+
+void PhysicalObject::handle_collision_response(const Rect &wall_rect)
 {
     Rect box_rect = this->get_rect();
-    Rect wall_rect = wall.get_rect();
 
     // 1. 计算两个物体在X和Y轴上“合并”后的半长和半宽
     float combined_half_w = (box_rect.get_width() + wall_rect.get_width()) * 0.5f;
@@ -206,7 +220,7 @@ void PhysicalObject::handle_collision_response(ObstacleObject &wall)
     if (vel_along_normal > 0)
         return;
 
-    float restitution = 0.8f;
+    float restitution = restitution_for(vel_along_normal, m_restitution);
     // 冲量公式 j 的分子是 -(1 + e) * v_rel_normal
     // 因为这里 v_rel_normal 已经保证是负数或零，所以整个冲量 j 是正数，代表一个推开的力
     float j = -(1 + restitution) * vel_along_normal;
@@ -254,7 +268,7 @@ void PhysicalObject::handle_collision_response(PhysicalObject &other)
     if (vel_along_normal > 0)
         return;
 
-    float restitution = 0.8f;
+    float restitution = restitution_for(vel_along_normal, std::max(m_restitution, other.m_restitution));
     float j = -(1 + restitution) * vel_along_normal;
     j /= (1 / m1 + 1 / m2);
 
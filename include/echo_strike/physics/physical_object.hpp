@@ -3,42 +3,121 @@
 
 #include <echo_strike/physics/object.hpp>
 #include <echo_strike/physics/obstacle_object.hpp>
+#include <echo_strike/physics/rigid_body_store.hpp>
 
 #include <echo_strike/collision/collision_layer.hpp>
 #include <echo_strike/collision/collision_box.hpp>
 #include <echo_strike/collision/collision_manager.hpp>
 
+#include <echo_strike/core/world.hpp>
+
 #include <iostream>
 
 class PhysicsManager;
 
+/*
+    动态物体。位置、速度、力、逆质量和边界保存在 PhysicsManager 的 RigidBodyStore 中,
+    这里只保存下标; 下面的访问函数覆盖了 Object 的虚函数, 通过 Object 指针读写的同样是存储中的数据,
+    Object 自身的 m_rect、m_speed 和 m_force 不使用。覆盖声明为 final, 经由 PhysicalObject 的调用不经过虚表。
+*/
 class PhysicalObject : public Object
 {
     friend PhysicsManager;
+    friend RigidBodyStore;
 
 private:
     CollisionBox &box;
     bool is_collided = false;
 
+    PhysicsManager &m_physics; // 所属世界的物理管理器; World 析构时 physics() 已经不可用, 注销时直接使用它
+    RigidBodyStore &m_store;
+    size_t m_handle; // 在 m_store 中的下标, 同时也是在 PhysicsManager::objects() 中的位置, 会随删除和休眠改变
+
+    // 休眠: 速度持续低于阈值的时间, 以及是否已经休眠。休眠的物体不参与物理步进。
+    float m_sleep_time = 0;
+    bool m_sleeping = false;
+    bool m_frozen = false; // 因超出时间预算而暂停模拟, 同时也处于休眠状态, 但保留速度
+
+    float m_restitution = 0.8f; // 恢复系数, 两个动态物体相撞时取较大的一个
+
+    // 事件驱动 CCD 的单物体状态, 由 PhysicsManager 在每帧内维护; 局部时间保存在存储中。
+    unsigned m_version = 0;  // 轨迹每改变一次加一, 用于淘汰过期的碰撞事件
+    int m_impacts = 0;       // 本帧已处理的碰撞次数
+    Rect m_sweep;            // 从局部时间到帧末的运动包围盒, 即在扫掠树中的位置
+    bool m_in_sweep = false; // 是否成功插入了扫掠树
+
+    Rect m_prev_rect; // 最近一次物理步进开始时的位置, 用于渲染插值
+
+    bool m_owned = false; // 由 PhysicsManager 创建并持有, clear 时删除
+
+public:
+    static constexpr BodyKind KIND = BodyKind::Physical;
+
 public:
-    PhysicalObject();
+    // 构造时登记到所属世界的 PhysicsManager, 析构时注销。直接构造的物体由调用者负责销毁, 并且要早于 World;
+    // 由 PhysicsManager::create_physical_object 创建的物体由管理器持有。
+    PhysicalObject() : PhysicalObject(World::instance()) {}
+    explicit PhysicalObject(World &);
 
     ~PhysicalObject();
 
 public:
+    Rect get_rect() const final { return m_store.rect(m_handle); }
+    // 视为瞬移: 同时重置插值起点, 渲染时不会从旧位置滑过来。
+    void set_rect(const Rect &rect) final;
+
+    // 以下修改在数值改变时会唤醒休眠的物体 (连同与它接触的整堆物体)。
+    Vec2 get_speed() const final { return m_store.speed(m_handle); }
+    void set_speed(const Vec2 &speed) final;
+
+    Vec2 get_force() const final { return m_store.force(m_handle); }
+    void set_force(const Vec2 &force) final;
+
+    void add_speed(const Vec2 &speed) override { set_speed(get_speed() + speed); }
+    void add_force(const Vec2 &force) override { set_force(get_force() + force); }
+
+    void set_mass(float mass);
+    void set_boundary(const Rect &boundary);
+    void set_motion_type(MotionType type);
+
+    // 把物体推进 time_step 秒。
     void advance_state(float time_step);
 
+    // alpha 为 0 时是上一次步进开始时的位置, 为 1 时是当前位置。
+    Rect get_interpolated_rect(float alpha) const;
+
+    float get_restitution() const { return m_restitution; }
+    void set_restitution(float restitution) { m_restitution = restitution; }
+
+    bool is_sleeping() const { return m_sleeping; }
+    bool is_frozen() const { return m_frozen; }
+    void wake_up();
+
+public:
+    void render_border(SDL_Renderer *renderer) const override { get_rect().render_border(renderer); }
+    void render_full(SDL_Renderer *renderer) const override { get_rect().render_full(renderer); }
+
 public:
     CollisionBox &collision_box() { return box; }
     const CollisionBox &collision_box() const { return box; }
 
 private:
-    std::pair<float, CollisionBox *> find_first_collision(float);
-    void resolve_penetration_pair(ObstacleObject &);
-    void resolve_penetration_pair(PhysicalObject &);
+    // 物理步进内部的位置修正, 不影响插值起点。
+    void move_rect(const Rect &rect);
+    void sync_box() { box.set_rect(get_rect()); }
+
+    float local_time() const { return m_store.time(m_handle); }
+    void update_boundary();
+
+    float find_first_tile_collision(const TileCollisionMap &, float, Rect &);
+
+    // 返回是否做了修正; 与物体和障碍物的重叠由 ContactSolver 修正。
+    bool resolve_penetration_tiles(const TileCollisionMap &);
 
     void handle_collision_response(ObstacleObject &);
     void handle_collision_response(PhysicalObject &);
+    void handle_collision_response(const Rect &wall_rect);
+    float restitution_for(float vel_along_normal, float restitution) const;
 };
 
 #endif // INCLUDE_PHYSICAL_OBJECT
\ No newline at end of file
@@ -1,110 +1,786 @@
 #include <echo_strike/physics/physics_manager.hpp>
 #include <echo_strike/physics/physical_object.hpp>
 
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+
 #include <algorithm>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <iostream>
 
 #include <SDL3/SDL_render.h>
 
 PhysicsManager &PhysicsManager::instance()
 {
-    static PhysicsManager manager;
-    return manager;
+    return World::instance().physics();
 }
 
 PhysicalObject *PhysicsManager::create_physical_object()
 {
-    auto obj = new PhysicalObject();
-    objs.push_back(obj);
+    auto obj = new PhysicalObject(*m_world);
+    obj->m_owned = true;
     return obj;
 }
 
 void PhysicsManager::destroy_physical_object(PhysicalObject *obj)
 {
-    objs.erase(
-        std::find(
-            objs.begin(),
-            objs.end(),
-            obj));
-
     delete obj;
 }
 
+/**
+ * @brief 由 PhysicalObject 的构造函数调用。存储已经在末尾为它分配了槽位, 这里追加到 objs 的相同位置,
+ * 再换到活动区的末尾, 保持活动物体连续。
+ */
+void PhysicsManager::attach(PhysicalObject *obj)
+{
+    objs.push_back(obj);
+    swap_bodies(obj->m_handle, m_awake_count++);
+}
+
+/**
+ * @brief 由 PhysicalObject 的析构函数调用。先移到休眠区的开头, 再用最后一个物体填补它的位置;
+ * 随后 RigidBodyStore 释放槽位时同样把最后一个物体搬到这个位置。
+ */
+void PhysicsManager::detach(PhysicalObject *obj)
+{
+    if (!obj->m_sleeping)
+        swap_bodies(obj->m_handle, --m_awake_count);
+    if (obj->m_frozen)
+        std::erase(m_frozen, obj);
+
+    objs[obj->m_handle] = objs.back();
+    objs.pop_back();
+}
+
+void PhysicsManager::swap_bodies(size_t a, size_t b)
+{
+    m_bodies.swap(a, b);
+    std::swap(objs[a], objs[b]);
+}
+
+// 网格格子在接触 key 中的编号: 最高位置 1, 与碰撞盒 id 区分
+static constexpr size_t TILE_KEY = static_cast<size_t>(1) << (sizeof(size_t) * 8 - 1);
+
+static Rect expand(const Rect &rect, float margin)
+{
+    return Rect(rect.get_x() - margin, rect.get_y() - margin,
+                rect.get_width() + margin * 2, rect.get_height() + margin * 2);
+}
+
+// 碰撞时间为 0 说明两者起始时已经接触 (或在容差内重叠)。
+// 只有当 a 相对 b 的速度以超过 min_speed 的速度指向 b 时才算一次碰撞, 法线取最小穿透轴, 与碰撞响应一致;
+// 否则刚被弹开或静止贴合的物体会不断触发碰撞。更慢的接近属于静止接触, 由接触求解器处理。
+static bool is_approaching(const Rect &a, const Vec2 &relative_velocity, const Rect &b, float min_speed)
+{
+    Vec2 n = a.center() - b.center(); // 从 b 指向 a 的向量
+    float overlap_x = (a.get_width() + b.get_width()) * 0.5f - std::abs(n.get_x());
+    float overlap_y = (a.get_height() + b.get_height()) * 0.5f - std::abs(n.get_y());
+
+    Vec2 normal = overlap_x < overlap_y ? Vec2(n.get_x() > 0 ? 1.0f : -1.0f, 0)
+                                        : Vec2(0, n.get_y() > 0 ? 1.0f : -1.0f);
+    return relative_velocity.dot(normal) < -min_speed;
+}
+
+/**
+ * @brief 事件驱动的连续碰撞检测。
+ * 每个物体维护自己的局部时间: 开始时为每个物体预测一次最早的碰撞并放入优先队列,
+ * 之后按时间顺序取出事件, 只把相撞的物体推进到碰撞时刻、更新速度并重新预测它们的事件,
+ * 其余物体保持不动; 所有事件处理完后再把每个物体推进到帧末。
+ * 因此单帧的开销与实际发生的碰撞数成正比, 而不是碰撞数乘以物体数。
+ * 帧初按力更新速度、预测碰撞, 帧末推进位置, 这些对每个物体相互独立, 设置了工作线程时按物体分块并行。
+ * 已经接触的物体 (例如堆叠) 不交给连续碰撞检测: 帧初由接触求解器把它们的速度修正到不再互相靠近,
+ * 帧末再由同一份接触列表修正残留的重叠。
+ * 休眠的物体排在 objs 末尾, 整个步进只遍历前 m_awake_count 个物体。
+ * 设置了时间预算时按上一步的耗时决定本步的降级级数, 见 time_budget。
+ */
 void PhysicsManager::on_update(float delta)
 {
-    float remaining_time = delta;
-    const int max_sub_steps = 25; // 安全措施，防止死循环
-    const float epsilon = 1e-5f;
+    using Clock = std::chrono::steady_clock;
+    auto step_start = Clock::now(), phase_start = step_start;
+    // 返回上一阶段结束以来的毫秒数
+    auto lap = [&]
+    {
+        auto now = Clock::now();
+        double ms = std::chrono::duration<double, std::milli>(now - phase_start).count();
+        phase_start = now;
+        return ms;
+    };
+
+    m_step_time = delta;
+    m_impact_count = 0;
+    m_stats = PhysicsStats();
+    m_predict.predictions = m_predict.candidates = m_predict.tests = 0;
+    for (auto &buffer : m_chunk_predicts)
+        buffer.predictions = buffer.candidates = buffer.tests = 0;
+
+    bool budgeted = m_time_budget > 0 && !m_deterministic;
+    int level = budgeted ? m_degrade_level : 0;
+    bool freeze = level >= 3 && m_active_region.get_width() > 0 && m_active_region.get_height() > 0;
+    if (!m_frozen.empty())
+        thaw_frozen(freeze);
+
+    m_impact_limit = level >= 1 ? DEGRADED_IMPACTS_PER_BODY : MAX_IMPACTS_PER_BODY;
+    int velocity_iterations = level >= 2 ? std::min(m_velocity_iterations, 2) : m_velocity_iterations;
+    int position_iterations = level >= 2 ? std::min(m_position_iterations, 1) : m_position_iterations;
+    if (level >= 1)
+        m_stats.degradations |= degradation_bit(PhysicsDegradation::CapImpacts);
+    if (level >= 2)
+        m_stats.degradations |= degradation_bit(PhysicsDegradation::ReduceIterations);
+    if (freeze)
+        m_stats.degradations |= degradation_bit(PhysicsDegradation::FreezeOffscreen);
+
+    // 冻结的物体不在扫掠树中, 与休眠物体一样需要提前唤醒
+    if (m_sleep_enabled || !m_frozen.empty())
+        wake_touched();
+    m_stats.awake_bodies = m_awake_count;
+    m_stats.wake_ms = lap();
+
+    m_bodies.reset_time(m_awake_count);
+    for_each_awake_range(
+        [&](size_t begin, size_t end, size_t)
+        { m_bodies.apply_forces(begin, end, delta); });
+
+    for (size_t i = 0; i < m_awake_count; ++i)
+    {
+        auto obj = objs[i];
+        obj->m_prev_rect = obj->get_rect();
+        obj->m_impacts = 0;
+        ++obj->m_version;
+    }
+    m_stats.forces_ms = lap();
+
+    collect_contacts();
+    m_solver.prepare(m_bodies, delta, m_restitution_threshold, m_speculative_contacts);
+    m_solver.solve_velocities(m_bodies, velocity_iterations);
+    m_stats.contacts = m_solver.contacts().size();
+    m_stats.velocity_iterations = velocity_iterations;
+    m_stats.contacts_ms = lap();
+
+    if (!m_speculative_contacts)
+        schedule_all();
+
+    size_t handled = 0;
+    while (!m_events.empty())
+    {
+        // 已经降级后本步仍然超时: 剩余的事件不再处理
+        if (level >= 1 && ++handled % BUDGET_CHECK_INTERVAL == 0 &&
+            std::chrono::duration<double, std::milli>(Clock::now() - step_start).count() > m_time_budget)
+        {
+            drop_events();
+            break;
+        }
+
+        ImpactEvent event = m_events.top();
+        m_events.pop();
+
+        // 参与者的轨迹在事件预测之后改变过, 事件作废; 需要的话已经在重新预测时补上。
+        if (event.body->m_version != event.body_version ||
+            (event.other && event.other->m_version != event.other_version))
+        {
+            ++m_stats.stale_events;
+            continue;
+        }
+
+        handle_impact(event);
+    }
+    m_stats.impacts = m_impact_count;
+    m_stats.ccd_ms = lap();
+
+    for_each_awake_range(
+        [&](size_t begin, size_t end, size_t)
+        { m_bodies.advance_range(begin, end, m_step_time); });
+    m_stats.advance_ms = lap();
+
+    m_stats.position_iterations = m_solver.solve_positions(m_bodies, position_iterations);
+    if (auto *tiles = m_world->collision().tile_map())
+        for (size_t i = 0; i < m_awake_count; ++i)
+            m_stats.tile_corrections += objs[i]->resolve_penetration_tiles(*tiles);
+
+    for (size_t i = 0; i < m_awake_count; ++i)
+    {
+        auto obj = objs[i];
+        obj->sync_box();
+        if (obj->m_in_sweep)
+            m_sweep_tree.remove(obj->m_sweep, obj);
+        obj->m_in_sweep = false;
+    }
+    m_stats.positions_ms = lap();
+
+    if (m_sleep_enabled)
+        update_sleep(delta);
+    if (freeze)
+        freeze_outside();
+    m_stats.frozen_bodies = m_frozen.size();
+    m_stats.sleep_ms = lap();
+
+    ++m_step_count;
+    if (m_deterministic)
+        m_state_hash = compute_state_hash();
+
+    // 并行预测时每个分块各自计数, 汇总后与串行相同
+    auto add_counts = [&](const PredictBuffer &buffer)
+    {
+        m_stats.predictions += buffer.predictions;
+        m_stats.broadphase_candidates += buffer.candidates;
+        m_stats.narrowphase_tests += buffer.tests;
+    };
+    add_counts(m_predict);
+    for (auto &buffer : m_chunk_predicts)
+        add_counts(buffer);
+    m_stats.total_ms = std::chrono::duration<double, std::milli>(Clock::now() - step_start).count();
+
+    if (!budgeted)
+        m_degrade_level = 0;
+    else if (m_stats.total_ms > m_time_budget)
+        m_degrade_level = std::min(level + 1, MAX_DEGRADE_LEVEL);
+    else if (m_stats.total_ms < m_time_budget * 0.5f)
+        m_degrade_level = std::max(level - 1, 0);
+
+    if (m_log_stats)
+        std::clog << m_stats << '\n';
+}
+
+bool PhysicsManager::LaterEvent::operator()(const ImpactEvent &lhs, const ImpactEvent &rhs) const
+{
+    if (lhs.time != rhs.time)
+        return lhs.time > rhs.time;
+
+    auto body_id = [](const ImpactEvent &event)
+    { return event.body->collision_box().get_id(); };
+    if (body_id(lhs) != body_id(rhs))
+        return body_id(lhs) > body_id(rhs);
+
+    auto other_id = [](const ImpactEvent &event) -> size_t
+    {
+        if (event.other)
+            return event.other->collision_box().get_id();
+        if (event.wall)
+            return event.wall->collision_box().get_id();
+        return -1;
+    };
+    if (other_id(lhs) != other_id(rhs))
+        return other_id(lhs) > other_id(rhs);
+
+    auto cell_position = lhs.cell.get_position(), rhs_position = rhs.cell.get_position();
+    if (cell_position.get_y() != rhs_position.get_y())
+        return cell_position.get_y() > rhs_position.get_y();
+    return cell_position.get_x() > rhs_position.get_x();
+}
+
+/**
+ * @brief 物体的轨迹改变后重新预测: 更新它在扫掠树中的位置, 再把新的碰撞事件入队。
+ */
+void PhysicsManager::schedule(PhysicalObject *obj)
+{
+    update_sweep(obj);
+    predict(obj, m_world->collision().static_tree(), m_predict);
+    push_events(m_predict);
+}
+
+/**
+ * @brief 帧初为所有物体预测碰撞。先把所有运动包围盒放入扫掠树, 之后的预测只读取共享数据,
+ * 可以按物体分块并行; 各分块的事件按物体顺序合并入队, 与串行时的入队顺序完全相同。
+ */
+void PhysicsManager::schedule_all()
+{
+    for (size_t i = 0; i < m_awake_count; ++i)
+        update_sweep(objs[i]);
 
-    for (int i = 0; i < max_sub_steps && remaining_time > 1e-6f; ++i)
+    auto &static_tree = m_world->collision().static_tree();
+
+    if (!m_pool || m_awake_count < PARALLEL_MIN_BODIES)
     {
-        float min_time_of_impact = remaining_time;
-        PhysicalObject *first_collider = nullptr;
-        CollisionBox *first_collided_with = nullptr;
+        for (size_t i = 0; i < m_awake_count; ++i)
+            predict(objs[i], static_tree, m_predict);
+        push_events(m_predict);
+        return;
+    }
 
-        // 1. 全局查找：在所有物理对象中，找到最早发生的碰撞
-        for (auto obj : objs)
+    m_chunk_predicts.resize(m_pool->chunk_count());
+    m_pool->parallel_for(
+        m_awake_count,
+        [&](size_t begin, size_t end, size_t chunk)
         {
-            auto [toi, other_box] = obj->find_first_collision(remaining_time);
+            auto &buffer = m_chunk_predicts[chunk];
+            for (size_t i = begin; i < end; ++i)
+                predict(objs[i], static_tree, buffer);
+        });
+
+    for (auto &buffer : m_chunk_predicts)
+        push_events(buffer);
+}
+
+void PhysicsManager::update_sweep(PhysicalObject *obj)
+{
+    float remaining = m_step_time - obj->local_time();
+    Rect rect = obj->get_rect();
+
+    if (obj->m_in_sweep)
+        m_sweep_tree.remove(obj->m_sweep, obj);
+    obj->m_sweep = Rect::bounding_box({rect, rect + obj->get_speed() * remaining});
+    obj->m_in_sweep = m_sweep_tree.insert(obj->m_sweep, obj);
+}
+
+void PhysicsManager::push_events(PredictBuffer &buffer)
+{
+    for (auto &event : buffer.events)
+        m_events.push(event);
+    buffer.events.clear();
+}
+
+/**
+ * @brief 从物体当前的局部时间出发, 预测它在帧末之前与动态物体、障碍物和网格的碰撞, 追加到 buffer。
+ * 所有碰撞都入队而不只是最早的一个: 较早的事件作废时, 较晚的事件可能依然有效。
+ * 只读取物体状态和各索引, 不同物体可以在不同线程上同时预测。
+ */
+void PhysicsManager::predict(PhysicalObject *obj, const QuadTree<CollisionBox> &static_tree, PredictBuffer &buffer) const
+{
+    float local_time = obj->local_time();
+    float remaining = m_step_time - local_time;
+    Rect rect = obj->get_rect();
+    Vec2 speed = obj->get_speed();
+
+    auto &box = obj->collision_box();
+    if (remaining <= 1e-6f || obj->m_impacts >= m_impact_limit || !box.get_enable())
+        return;
+    ++buffer.predictions;
+
+    auto push = [&](float time, PhysicalObject *other, ObstacleObject *wall, const Rect &cell)
+    {
+        buffer.events.push_back({time, obj, other, wall, cell, obj->m_version, other ? other->m_version : 0});
+    };
+
+    // 1. 动态物体: 两者先外推到共同的时刻, 再用相对速度求碰撞时间。
+    buffer.sweep_candidates.clear();
+    m_sweep_tree.query(obj->m_sweep, buffer.sweep_candidates);
+    buffer.candidates += buffer.sweep_candidates.size();
+    for (auto other : buffer.sweep_candidates)
+    {
+        auto &other_box = other->collision_box();
+        if (other == obj || !other_box.get_enable() || !box.has_dst(other_box.get_src()))
+            continue;
+        ++buffer.tests;
+
+        float t0 = std::max(local_time, other->local_time());
+        Rect a = rect + speed * (t0 - local_time);
+        Rect b = other->get_rect() + other->get_speed() * (t0 - other->local_time());
+
+        Vec2 relative_speed = speed - other->get_speed();
+        float t = shape_time_to_collide(box.get_shape(), a, relative_speed, other_box.get_shape(), b);
+        if (t >= 0 && t <= 1e-6f && !is_approaching(a, relative_speed, b, m_restitution_threshold))
+            continue;
+        if (t >= 0 && t0 + t <= m_step_time)
+            push(t0 + t, other, nullptr, Rect());
+    }
+
+    // 2. 障碍物: 静态索引在帧内不会变化。
+    buffer.static_candidates.clear();
+    static_tree.query(obj->m_sweep, buffer.static_candidates);
+    buffer.candidates += buffer.static_candidates.size();
+    for (auto other_box : buffer.static_candidates)
+    {
+        if (!other_box->get_enable() || !box.has_dst(other_box->get_src()))
+            continue;
 
-            // 我们关心的是在剩余时间内、比当前记录还要早的碰撞
-            if (other_box && toi < min_time_of_impact)
+        auto wall = body_cast<ObstacleObject>(other_box->get_object());
+        if (!wall)
+            continue;
+        ++buffer.tests;
+
+        float t = shape_time_to_collide(box.get_shape(), rect, speed, other_box->get_shape(), other_box->get_rect());
+        if (t >= 0 && t <= 1e-6f && !is_approaching(rect, speed, other_box->get_rect(), m_restitution_threshold))
+            continue;
+        if (t >= 0 && t <= remaining)
+            push(local_time + t, nullptr, wall, Rect());
+    }
+
+    // 3. 网格几何
+    if (auto *tiles = m_world->collision().tile_map())
+    {
+        Rect cell;
+        float t = obj->find_first_tile_collision(*tiles, remaining, cell);
+        if (t >= 0)
+            push(local_time + t, nullptr, nullptr, cell);
+    }
+}
+
+/**
+ * @brief 超出时间预算时丢弃剩余的碰撞事件。
+ * 参与者推进到碰撞时刻后停在原地直到帧末 (速度不变), 不做碰撞响应但也不会穿过对方;
+ * 下一步开始时它们正好接触, 碰撞在那时处理。
+ */
+void PhysicsManager::drop_events()
+{
+    m_stats.dropped_events += m_events.size();
+    for (; !m_events.empty(); m_events.pop())
+    {
+        const ImpactEvent &event = m_events.top();
+        if (event.body->m_version != event.body_version ||
+            (event.other && event.other->m_version != event.other_version))
+            continue;
+
+        for (auto body : {event.body, event.other})
+            if (body)
             {
-                min_time_of_impact = toi;
-                first_collider = obj;
-                first_collided_with = other_box;
+                advance_to(body, event.time);
+                m_bodies.set_time(body->m_handle, m_step_time);
             }
+    }
+}
+
+void PhysicsManager::advance_to(PhysicalObject *obj, float time)
+{
+    if (time > obj->local_time())
+    {
+        m_bodies.advance(obj->m_handle, time);
+        obj->sync_box();
+    }
+}
+
+/**
+ * @brief 把参与碰撞的物体推进到碰撞时刻, 此刻它们正好处在完美接触的状态,
+ * 调用碰撞响应来更新速度, 然后让它们旧的事件作废并重新预测。
+ */
+void PhysicsManager::handle_impact(const ImpactEvent &event)
+{
+    auto body = event.body;
+    advance_to(body, event.time);
+    if (event.other)
+        advance_to(event.other, event.time);
+
+    if (event.other)
+        body->handle_collision_response(*event.other);
+    else if (event.wall)
+        body->handle_collision_response(*event.wall);
+    else
+        body->handle_collision_response(event.cell);
+
+    ++m_impact_count;
+
+    ++body->m_impacts;
+    m_stats.impact_limit_hits += body->m_impacts == m_impact_limit;
+    ++body->m_version;
+    schedule(body);
+
+    if (event.other)
+    {
+        ++event.other->m_impacts;
+        m_stats.impact_limit_hits += event.other->m_impacts == m_impact_limit;
+        ++event.other->m_version;
+        schedule(event.other);
+    }
+}
+
+/**
+ * @brief 每步只做一次的宽阶段: 找出每个活动物体接触或在容差内靠近的动态物体和障碍物, 交给求解器。
+ * 一对动态物体只由碰撞盒 id 较小的一方添加; 接触到的休眠物体已经在 wake_touched 中被唤醒。
+ * 投机接触模式下查询范围是本步的扫掠包围盒再向外扩展任何物体一步内的最大位移,
+ * 两个相向而行、各自的扫掠都碰不到对方当前位置的物体也能被找到。
+ */
+void PhysicsManager::collect_contacts()
+{
+    m_solver.begin();
+    auto &collision = m_world->collision();
+    // 新建或瞬移过的盒子还没有插入四叉树, 查询时会被逐个检查; 先 flush 一次。
+    collision.flush();
+
+    float reach = 0;
+    if (m_speculative_contacts)
+        for (size_t i = 0; i < m_awake_count; ++i)
+        {
+            Vec2 speed = objs[i]->get_speed();
+            reach = std::max(reach, std::max(std::abs(speed.get_x()), std::abs(speed.get_y())) * m_step_time);
         }
 
-        // 2. 推进时间
-        // 如果找到的碰撞时间非常小 (几乎为零)，说明物体可能已经重叠或紧贴
-        // 为了避免浮点数精度问题导致的无限循环，我们至少推进一个极小的时间步
-        // 或者直接处理穿透并继续。这里我们选择推进一个最小步长来避免卡死。
-        if (min_time_of_impact < 1e-6f && first_collider)
+    // 物体本步可能与之接触的范围
+    auto contact_area = [&](const PhysicalObject *obj)
+    {
+        Rect rect = obj->get_rect();
+        if (!m_speculative_contacts)
+            return expand(rect, CONTACT_MARGIN);
+        Rect sweep = Rect::bounding_box({rect, rect + obj->get_speed() * m_step_time});
+        return expand(sweep, CONTACT_MARGIN + reach);
+    };
+
+    for (size_t i = 0; i < m_awake_count; ++i)
+    {
+        auto obj = objs[i];
+        auto &box = obj->collision_box();
+        if (!box.get_enable())
+            continue;
+
+        m_touching.clear();
+        collision.overlap_rect(contact_area(obj), ALL_COLLISION_LAYERS, m_touching);
+        for (auto other_box : m_touching)
         {
-            // 这种情况通常意味着已经有接触，先处理碰撞响应
-            if (auto wall = dynamic_cast<ObstacleObject *>(first_collided_with->get_object()))
+            if (other_box == &box || other_box->is_sensor() || !box.has_dst(other_box->get_src()))
+                continue;
+
+            // 含圆或胶囊体的一对按形状间距筛选: 包围盒相交、形状之间仍有间隙 (例如斜对着的两个圆) 的不是接触。
+            // 间距对两者是对称的, 一对动态物体无论由哪一方添加结果都相同; 投机接触要保留尚有间隙的物体对。
+            ShapeType shape = box.get_shape(), other_shape = other_box->get_shape();
+            if (!m_speculative_contacts && (shape != ShapeType::Rect || other_shape != ShapeType::Rect))
             {
-                first_collider->resolve_penetration_pair(*wall);
-                first_collider->handle_collision_response(*wall);
+                Vec2 normal;
+                float separation;
+                shape_contact(shape, obj->get_rect(), other_shape, other_box->get_rect(), normal, separation);
+                if (separation > CONTACT_MARGIN)
+                    continue;
             }
-            else if (auto other_obj = dynamic_cast<PhysicalObject *>(first_collided_with->get_object()))
+
+            auto key = std::make_pair(box.get_id(), other_box->get_id());
+            if (body_cast<ObstacleObject>(other_box->get_object()))
+                m_solver.add(i, ContactSolver::NO_BODY, other_box->get_rect(), key, obj->get_restitution(), shape,
+                             other_shape);
+            else if (auto other = body_cast<PhysicalObject>(other_box->get_object()))
             {
-                first_collider->resolve_penetration_pair(*other_obj);
-                first_collider->handle_collision_response(*other_obj);
+                if (other->m_sleeping)
+                    continue;
+                // 对方也会找到这一对时, 由 id 较小的一方添加
+                if (key.first > key.second && other_box->has_dst(box.get_src()) &&
+                    contact_area(other).is_intersect(obj->get_rect()))
+                    continue;
+                m_solver.add(i, other->m_handle, Rect(), key,
+                             std::max(obj->get_restitution(), other->get_restitution()), shape, other_shape);
             }
         }
-        else
+
+        if (m_speculative_contacts)
+            collect_tile_contacts(i);
+    }
+}
+
+/**
+ * @brief 投机接触模式下把扫掠范围内的网格格子作为固定法线的接触。
+ * 法线只取朝向空格子的面, 与 resolve_penetration_tiles 一致, 连成一片的地面不会在接缝处挡住滑动的物体;
+ * 单向平台只有物体中心在格子上方时才向上托住它。
+ */
+void PhysicsManager::collect_tile_contacts(size_t index)
+{
+    auto *tiles = m_world->collision().tile_map();
+    if (!tiles)
+        return;
+
+    auto obj = objs[index];
+    Rect rect = obj->get_rect();
+    Vec2 motion = obj->get_speed() * m_step_time;
+    size_t id = obj->collision_box().get_id();
+
+    tiles->for_each_tile(
+        expand(Rect::bounding_box({rect, rect + motion}), CONTACT_MARGIN),
+        [&](const Rect &cell, TileType type)
         {
-            // 将所有物体的时间统一推进 min_time_of_impact
-            for (auto obj : objs)
+            Vec2 normal;
+            float separation;
+            if (!ContactSolver::swept_face_contact(rect, motion, cell, normal, separation))
+                return;
+
+            int col = tiles->col_of(cell.center().get_x());
+            int row = tiles->row_of(cell.center().get_y());
+            Vec2 n = rect.center() - cell.center();
+            int dir_x = n.get_x() > 0 ? 1 : -1;
+            int dir_y = n.get_y() > 0 ? 1 : -1;
+
+            bool open_x = type == TileType::Solid && tiles->get_tile(col + dir_x, row) != TileType::Solid;
+            bool open_y = tiles->get_tile(col, row + dir_y) != TileType::Solid;
+            if (type == TileType::OneWay)
+                open_y = open_y && dir_y < 0 && rect.center().get_y() < cell.bottom();
+
+            // 选中的面被相邻的实心格子挡住时改用另一个轴
+            bool along_x = normal.get_x() != 0;
+            if (along_x ? !open_x : !open_y)
             {
-                obj->advance_state(min_time_of_impact);
+                if (along_x ? !open_y : !open_x)
+                    return;
+                normal = along_x ? Vec2(0, static_cast<float>(dir_y)) : Vec2(static_cast<float>(dir_x), 0);
             }
-        }
 
-        // 3. 处理碰撞
-        if (first_collider && first_collided_with)
+            size_t cell_key = TILE_KEY | (static_cast<size_t>(row) * tiles->get_cols() + col);
+            m_solver.add(index, cell, normal, std::make_pair(id, cell_key), obj->get_restitution());
+        });
+}
+
+void PhysicsManager::for_each_awake_range(const ThreadPool::RangeTask &func)
+{
+    if (!m_pool || m_awake_count < PARALLEL_MIN_BODIES)
+        func(0, m_awake_count, 0);
+    else
+        m_pool->parallel_for(m_awake_count, func);
+}
+
+void PhysicsManager::set_worker_count(size_t count)
+{
+    if (count <= 1)
+        m_pool.reset();
+    else if (get_worker_count() != count)
+        m_pool = std::make_unique<ThreadPool>(count - 1);
+}
+
+void PhysicsManager::on_frame(float delta)
+{
+    m_frame_steps = 0;
+    m_dropped_time = 0;
+
+    if (!uses_fixed_step())
+    {
+        on_update(delta);
+        m_frame_steps = 1;
+        return;
+    }
+
+    m_accumulator += std::max(delta, 0.0f);
+    while (m_accumulator >= m_tick && m_frame_steps < m_max_steps_per_frame)
+    {
+        on_update(m_tick);
+        m_accumulator -= m_tick;
+        ++m_frame_steps;
+    }
+
+    // 达到上限时只保留不足一个 tick 的部分, 宁可让模拟变慢也不要越积越多。
+    if (m_accumulator >= m_tick)
+    {
+        float kept = std::fmod(m_accumulator, m_tick);
+        m_dropped_time = m_accumulator - kept;
+        m_accumulator = kept;
+    }
+}
+
+Rect PhysicsManager::interpolated_rect(const PhysicalObject &obj) const
+{
+    return obj.get_interpolated_rect(get_interpolation_alpha());
+}
+
+static uint64_t mix_hash(uint64_t h)
+{
+    // splitmix64 的终结函数, 输入的每一位都会影响输出的每一位
+    h ^= h >> 30, h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27, h *= 0x94d049bb133111ebull;
+    return h ^ (h >> 31);
+}
+
+/**
+ * @brief 每个物体以碰撞盒 id 为种子依次混入各字段的位模式, 再把所有物体的结果相加。
+ * 加法与顺序无关, 休眠交换或删除物体改变了内部排列也不影响结果; 不需要每步排序。
+ */
+uint64_t PhysicsManager::compute_state_hash() const
+{
+    uint64_t hash = mix_hash(objs.size());
+    for (size_t i = 0; i < objs.size(); ++i)
+    {
+        Rect rect = m_bodies.rect(i);
+        Vec2 speed = m_bodies.speed(i);
+        float fields[] = {rect.get_x(), rect.get_y(), rect.get_width(), rect.get_height(), speed.get_x(), speed.get_y()};
+
+        uint64_t h = mix_hash(objs[i]->collision_box().get_id());
+        for (float field : fields)
+            h = mix_hash(h ^ std::bit_cast<uint32_t>(field));
+        hash += mix_hash(h ^ objs[i]->m_sleeping);
+    }
+    return hash;
+}
+
+static CollisionLayerMask dst_mask(const CollisionBox &box)
+{
+    CollisionLayerMask mask = 0;
+    for (auto layer : box.get_dst())
+        mask |= layer_mask(layer);
+    return mask;
+}
+
+PhysicsSnapshot PhysicsManager::snapshot() const
+{
+    PhysicsSnapshot out;
+    snapshot(out);
+    return out;
+}
+
+void PhysicsManager::snapshot(PhysicsSnapshot &out) const
+{
+    m_bodies.save(out.m_bodies);
+
+    out.m_records.resize(objs.size());
+    out.m_end_id = 0;
+    for (size_t i = 0; i < objs.size(); ++i)
+    {
+        auto obj = objs[i];
+        auto &box = obj->collision_box();
+        out.m_records[i] = {obj, obj->m_prev_rect, obj->move_dir, obj->move_ctrl, obj->m_type, obj->m_boundary,
+                            obj->m_mass, obj->m_restitution, obj->m_sleep_time, obj->m_sleeping, obj->m_frozen,
+                            box.get_enable(), box.get_shape(), box.get_src(), dst_mask(box)};
+        out.m_end_id = std::max(out.m_end_id, obj->collision_box().get_id() + 1);
+    }
+
+    out.m_contacts = m_solver.contacts();
+    out.m_awake_count = m_awake_count;
+    out.m_accumulator = m_accumulator;
+    out.m_step_count = m_step_count;
+    out.m_state_hash = m_state_hash;
+}
+
+/**
+ * @brief 按快照中的顺序恢复物体排列和状态, 并把碰撞盒同步到恢复后的位置。
+ * 碰撞盒 id 单调递增, 保存后新建的物体 id 一定不小于 m_end_id; 物体数相同且没有这样的物体,
+ * 说明仍是保存时的那一组, 快照中的指针都还有效。
+ */
+bool PhysicsManager::restore(const PhysicsSnapshot &snapshot)
+{
+    if (snapshot.m_records.size() != objs.size())
+        return false;
+    for (auto obj : objs)
+        if (obj->collision_box().get_id() >= snapshot.m_end_id)
+            return false;
+
+    for (size_t i = 0; i < objs.size(); ++i)
+    {
+        const auto &record = snapshot.m_records[i];
+        auto obj = objs[i] = record.object;
+        obj->m_prev_rect = record.prev_rect;
+        obj->move_dir = record.move_dir;
+        obj->move_ctrl = record.move_ctrl;
+        obj->m_type = record.motion_type;
+        obj->m_boundary = record.boundary;
+        obj->m_mass = record.mass;
+        obj->m_restitution = record.restitution;
+        obj->m_sleep_time = record.sleep_time;
+        obj->m_sleeping = record.sleeping;
+        obj->m_frozen = record.frozen;
+
+        auto &box = obj->collision_box();
+        box.set_enable(record.box_enable);
+        box.set_shape(record.box_shape);
+        box.set_src(record.box_src);
+        // 目标层没有变化时不重建集合, 恢复不分配内存
+        if (dst_mask(box) != record.box_dst)
         {
-            // 此刻，first_collider 和 first_collided_with 的物体正好处在完美接触的状态
-            // 调用碰撞响应来更新它们的速度
-            if (auto wall = dynamic_cast<ObstacleObject *>(first_collided_with->get_object()))
-                first_collider->handle_collision_response(*wall);
-            else if (auto other_obj = dynamic_cast<PhysicalObject *>(first_collided_with->get_object()))
-                first_collider->handle_collision_response(*other_obj);
+            box.get_dst().clear();
+            for (unsigned layer = 0; layer < 32; ++layer)
+                if (record.box_dst & (CollisionLayerMask(1) << layer))
+                    box.add_dst(static_cast<CollisionLayer>(layer));
         }
-
-        // 4. 更新剩余时间
-        remaining_time -= min_time_of_impact;
+    }
+    m_bodies.load(snapshot.m_bodies, objs);
+    m_frozen.clear();
+    for (auto obj : objs)
+    {
+        obj->sync_box();
+        if (obj->m_frozen)
+            m_frozen.push_back(obj);
     }
 
-    // 在整个物理步进循环结束后，作为一个安全网，再处理一遍可能因精度问题残留的穿透
-    resolve_all_penetrations();
+    m_solver.set_contacts(snapshot.m_contacts);
+    m_awake_count = snapshot.m_awake_count;
+    m_accumulator = snapshot.m_accumulator;
+    m_step_count = snapshot.m_step_count;
+    m_state_hash = snapshot.m_state_hash;
+    return true;
 }
 
 void PhysicsManager::render(SDL_Renderer *renderer)
 {
     for (auto *p : objs)
-        p->render_full(renderer);
+        interpolated_rect(*p).render_full(renderer);
 }
 
 PhysicsManager::~PhysicsManager()
@@ -114,58 +790,215 @@ PhysicsManager::~PhysicsManager()
 
 void PhysicsManager::clear()
 {
+    // 直接构造的物体由调用者持有, 留在管理器中
     auto destroy_objects = objs;
     for (auto obj : destroy_objects)
-        destroy_physical_object(obj);
-    objs.clear();
+        if (obj->m_owned)
+            destroy_physical_object(obj);
 }
 
-void PhysicsManager::resolve_all_penetrations()
+void PhysicsManager::find_touching(PhysicalObject *obj, const Rect &area, std::vector<PhysicalObject *> &out)
 {
-    const int max_iterations = 10;
-    for (int i = 0; i < max_iterations; ++i)
-    {
-        was_any_overlap_found = false;
-        for (auto obj : objs)
-        {
-            auto &box = obj->collision_box();
-            auto overlapping_boxes = box.process_collide();
+    m_touching.clear();
+    m_world->collision().overlap_rect(area, ALL_COLLISION_LAYERS, m_touching);
 
-            for (auto other_box : overlapping_boxes)
-            {
-                handle_collision(box, other_box);
-            }
-        }
-        if (!was_any_overlap_found)
-            break;
+    auto &box = obj->collision_box();
+    for (auto other_box : m_touching)
+    {
+        auto other = body_cast<PhysicalObject>(other_box->get_object());
+        if (other && other != obj && box.has_dst(other_box->get_src()))
+            out.push_back(other);
     }
 }
 
-void PhysicsManager::handle_collision(CollisionBox &src, CollisionBox *dst)
+/**
+ * @brief 唤醒物体, 再沿接触关系依次唤醒与它相连的休眠物体, 使整堆物体一起醒来。
+ */
+void PhysicsManager::wake_up(PhysicalObject *obj)
 {
-    if (dst == nullptr)
+    if (!obj->m_sleeping)
         return;
 
-    if (!src.get_rect().is_intersect(dst->get_rect()))
+    m_wake_stack.clear();
+    m_wake_stack.push_back(obj);
+    while (!m_wake_stack.empty())
+    {
+        auto body = m_wake_stack.back();
+        m_wake_stack.pop_back();
+        if (!body->m_sleeping)
+            continue;
+
+        body->m_sleeping = body->m_frozen = false;
+        body->m_sleep_time = 0;
+        body->m_prev_rect = body->get_rect();
+        m_bodies.set_time(body->m_handle, m_step_time);
+        swap_bodies(body->m_handle, m_awake_count++);
+
+        size_t begin = m_wake_stack.size();
+        find_touching(body, expand(body->get_rect(), CONTACT_MARGIN), m_wake_stack);
+        m_wake_stack.erase(
+            std::remove_if(
+                m_wake_stack.begin() + begin,
+                m_wake_stack.end(),
+                [](PhysicalObject *other)
+                { return !other->m_sleeping; }),
+            m_wake_stack.end());
+    }
+}
+
+void PhysicsManager::wake_in(const Rect &area)
+{
+    if (m_awake_count == objs.size())
         return;
 
-    auto obj = dynamic_cast<PhysicalObject *>(src.get_object());
+    m_touching.clear();
+    m_world->collision().overlap_rect(expand(area, CONTACT_MARGIN), ALL_COLLISION_LAYERS, m_touching);
+
+    m_touched_sleepers.clear();
+    for (auto box : m_touching)
+        if (auto body = body_cast<PhysicalObject>(box->get_object()); body && body->m_sleeping)
+            m_touched_sleepers.push_back(body);
 
-    auto other_obj_base = dst->get_object();
-    if (!other_obj_base)
+    for (auto body : m_touched_sleepers)
+        wake_up(body);
+}
+
+/**
+ * @brief 步进开始前, 唤醒活动物体在本步内可能碰到的休眠物体。
+ * 休眠物体不在扫掠树中, 连续碰撞检测看不到它们, 因此按整步的运动包围盒提前唤醒。
+ */
+void PhysicsManager::wake_touched()
+{
+    if (m_awake_count == objs.size())
         return;
 
-    if (auto wall = dynamic_cast<ObstacleObject *>(other_obj_base))
+    m_world->collision().flush();
+
+    // 被唤醒的物体排在活动区末尾, 它们自己也会被检查。
+    for (size_t i = 0; i < m_awake_count; ++i)
+    {
+        auto obj = objs[i];
+        Rect rect = obj->get_rect();
+        Rect sweep = Rect::bounding_box({rect, rect + obj->get_speed() * m_step_time});
+
+        m_touched_sleepers.clear();
+        find_touching(obj, expand(sweep, CONTACT_MARGIN), m_touched_sleepers);
+        for (auto other : m_touched_sleepers)
+            wake_up(other);
+    }
+}
+
+size_t PhysicsManager::find_island(size_t index)
+{
+    while (m_island_parent[index] != index)
     {
-        obj->resolve_penetration_pair(*wall);
-        was_any_overlap_found = true;
+        m_island_parent[index] = m_island_parent[m_island_parent[index]];
+        index = m_island_parent[index];
     }
-    else if (auto other_obj = dynamic_cast<PhysicalObject *>(other_obj_base))
+    return index;
+}
+
+/**
+ * @brief 更新休眠计时, 用并查集把互相接触的活动物体合并成岛, 整岛一起决定是否休眠。
+ * 只有岛内每个物体都已静止足够久, 岛才会休眠; 仍然活动的岛唤醒与它接触的休眠物体。
+ * 障碍物和网格不参与合并, 否则放在同一块地面上的所有物体都会连成一个岛。
+ */
+void PhysicsManager::update_sleep(float delta)
+{
+    size_t count = m_awake_count;
+
+    // 本步移动过的盒子还没有重新插入四叉树, 查询时会被逐个检查; 先 flush 一次。
+    m_world->collision().flush();
+
+    m_island_parent.resize(count);
+    m_island_awake.assign(count, false);
+    for (size_t i = 0; i < count; ++i)
+        m_island_parent[i] = i;
+
+    m_touched_sleepers.clear();
+    for (size_t i = 0; i < count; ++i)
     {
-        if (obj < other_obj)
+        auto obj = objs[i];
+        if (obj->get_speed().length() < m_sleep_speed)
+            obj->m_sleep_time += delta;
+        else
+            obj->m_sleep_time = 0;
+
+        m_neighbours.clear();
+        find_touching(obj, expand(obj->get_rect(), CONTACT_MARGIN), m_neighbours);
+        for (auto other : m_neighbours)
         {
-            obj->resolve_penetration_pair(*other_obj);
-            was_any_overlap_found = true;
+            if (other->m_sleeping)
+                m_touched_sleepers.push_back(obj), m_touched_sleepers.push_back(other);
+            else
+                m_island_parent[find_island(i)] = find_island(other->m_handle);
         }
     }
-}
\ No newline at end of file
+
+    for (size_t i = 0; i < count; ++i)
+        if (objs[i]->m_sleep_time < m_time_to_sleep)
+            m_island_awake[find_island(i)] = true;
+
+    // 仍然活动的岛碰到了休眠物体: 把它们唤醒, 下一步一起参与模拟。
+    for (size_t i = 0; i < m_touched_sleepers.size(); i += 2)
+        if (m_island_awake[find_island(m_touched_sleepers[i]->m_handle)])
+            wake_up(m_touched_sleepers[i + 1]);
+
+    // 从后往前让物体入睡: 与活动区末尾交换的物体已经处理过, 不会被跳过。
+    for (size_t i = count; i-- > 0;)
+    {
+        auto obj = objs[i];
+        if (m_island_awake[find_island(i)])
+            continue;
+
+        obj->m_sleeping = true;
+        obj->m_prev_rect = obj->get_rect();
+        m_bodies.set_speed(i, Vec2(0, 0));
+        swap_bodies(i, --m_awake_count);
+    }
+}
+
+/**
+ * @brief 步进开始时唤醒冻结的物体, 从而按保留的速度继续运动。
+ * keep_outside 为真时仍然处于最高一级降级, 只唤醒回到活动区域内的物体。
+ * 期间被碰到而唤醒过的物体 m_frozen 已经清除, 直接从列表中去掉。
+ */
+void PhysicsManager::thaw_frozen(bool keep_outside)
+{
+    size_t kept = 0;
+    for (size_t i = 0; i < m_frozen.size(); ++i)
+    {
+        auto obj = m_frozen[i];
+        if (!obj->m_frozen)
+            continue;
+        if (keep_outside && !m_active_region.is_intersect(obj->get_rect()))
+            m_frozen[kept++] = obj;
+        else
+            wake_up(obj);
+    }
+    m_frozen.resize(kept);
+}
+
+/**
+ * @brief 把与活动区域不相交的活动物体移入休眠区并标记为冻结。
+ * 与休眠不同, 速度保持不变; 插值起点设为当前位置, 渲染时停在原地。
+ */
+void PhysicsManager::freeze_outside()
+{
+    // 本步内被唤醒过的物体可能仍在列表中, 先去掉, 避免重新冻结时重复加入
+    std::erase_if(m_frozen, [](PhysicalObject *obj)
+                  { return !obj->m_frozen; });
+
+    for (size_t i = m_awake_count; i-- > 0;)
+    {
+        auto obj = objs[i];
+        if (m_active_region.is_intersect(obj->get_rect()))
+            continue;
+
+        obj->m_sleeping = obj->m_frozen = true;
+        obj->m_sleep_time = 0;
+        obj->m_prev_rect = obj->get_rect();
+        swap_bodies(i, --m_awake_count);
+        m_frozen.push_back(obj);
+    }
+}
@@ -1,43 +1,263 @@
 #ifndef INCLUDE_PHYSICS_MANAGER
 #define INCLUDE_PHYSICS_MANAGER
 
+#include <echo_strike/utils/class_marcos.hpp>
+#include <echo_strike/core/thread_pool.hpp>
+#include <echo_strike/utils/quadtree.hpp>
+#include <echo_strike/physics/rigid_body_store.hpp>
+#include <echo_strike/physics/contact_solver.hpp>
+#include <echo_strike/physics/physics_snapshot.hpp>
+#include <echo_strike/physics/physics_stats.hpp>
+#include <echo_strike/transform/rect.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <queue>
 #include <vector>
 
 class PhysicalObject;
+class ObstacleObject;
 class CollisionBox;
+class World;
 
 struct SDL_Renderer;
 
 class PhysicsManager
 {
+    friend class World;
+    friend class PhysicalObject;
+
 public:
     static PhysicsManager &instance();
+    // 创建由管理器持有的物体, clear 或析构时一并删除。
     PhysicalObject *create_physical_object();
     void destroy_physical_object(PhysicalObject *);
 
+    // 推进一次物理步进, 单位为秒。
     void on_update(float);
+
+    // 每个渲染帧调用一次。固定步长模式下把帧间隔累积起来, 每凑够一个 tick 调用一次 on_update,
+    // 每帧最多 max_steps_per_frame 次, 超出的时间直接丢弃; 否则等同于 on_update。
+    void on_frame(float);
+
+    // 按插值后的位置绘制, 与 on_frame 配合使用可以让渲染帧率与物理频率无关。
     void render(SDL_Renderer *);
 
 private:
-    std::vector<PhysicalObject *> objs;
-    bool was_any_overlap_found = false;
+    // 预测的一次碰撞。物体的轨迹每改变一次版本号就加一, 版本号不匹配的事件已经过期。
+    struct ImpactEvent
+    {
+        float time;
+        PhysicalObject *body;
+        PhysicalObject *other; // 另一个动态物体
+        ObstacleObject *wall;  // 障碍物
+        Rect cell;             // other 与 wall 都为空时表示撞到网格中的这个格子
+        unsigned body_version;
+        unsigned other_version;
+    };
+
+    // 时间早的先出队; 同一时刻按碰撞盒 id 排序, 保证处理顺序与指针地址无关。
+    struct LaterEvent
+    {
+        bool operator()(const ImpactEvent &, const ImpactEvent &) const;
+    };
+
+    // 预测碰撞时使用的临时缓冲区, 并行时每个分块一份。
+    struct PredictBuffer
+    {
+        std::vector<PhysicalObject *> sweep_candidates;
+        std::vector<CollisionBox *> static_candidates;
+        std::vector<ImpactEvent> events;
+
+        // 统计, 每步开始时清零, 结束时汇总到 PhysicsStats
+        size_t predictions = 0;
+        size_t candidates = 0;
+        size_t tests = 0;
+    };
 
 private:
-    PhysicsManager() = default;
+    World *m_world;
+    std::vector<PhysicalObject *> objs; // 与 m_bodies 下标一一对应, 活动的物体在前, 休眠的在后
+    RigidBodyStore m_bodies;
+    size_t m_awake_count = 0;
+
+    // 事件驱动的连续碰撞检测: 每个物体有自己的局部时间, 只在自己发生碰撞时推进并重新预测。
+    // 扫掠树存放每个物体从局部时间到帧末的运动包围盒, 用于找出可能相撞的动态物体。
+    std::priority_queue<ImpactEvent, std::vector<ImpactEvent>, LaterEvent> m_events;
+    QuadTree<PhysicalObject> m_sweep_tree;
+    PredictBuffer m_predict;
+    float m_step_time = 0;
+    size_t m_impact_count = 0;
+
+    // 每个物体每帧最多处理的碰撞次数, 防止堆叠在一起的物体无限互相触发; 超出时间预算时降为 DEGRADED_IMPACTS_PER_BODY。
+    static constexpr int MAX_IMPACTS_PER_BODY = 25;
+    static constexpr int DEGRADED_IMPACTS_PER_BODY = 4;
+    int m_impact_limit = MAX_IMPACTS_PER_BODY;
+
+    // 帧初的碰撞预测与帧末的积分按物体分块并行; 物体太少时线程调度的开销比计算本身还大。
+    std::unique_ptr<ThreadPool> m_pool;
+    std::vector<PredictBuffer> m_chunk_predicts;
+    static constexpr size_t PARALLEL_MIN_BODIES = 256;
+
+    // 固定步长
+    float m_tick = 1.0f / 60;
+    float m_accumulator = 0;
+
+    // 每步开始时收集一次接触, 速度和位置都只在这份列表上迭代求解。
+    ContactSolver m_solver;
+    CLASS_PROPERTY(int, velocity_iterations)
+    CLASS_PROPERTY(int, position_iterations)
+    CLASS_PROPERTY(float, restitution_threshold) // 接近速度低于它的碰撞不反弹, 视为静止接触
+
+    // 投机接触模式: 不做事件驱动的连续碰撞检测, 改为每步一次宽阶段收集本步内可能相遇的物体对 (包括网格格子),
+    // 由求解器把接近速度限制为恰好在步末接触, 然后所有物体一次推进到帧末。
+    // 开销固定为每步一次查询, 同样不会穿透; 代价是反弹推迟一步, 斜着擦过的物体可能被提前挡住。
+    CLASS_PROPERTY(bool, speculative_contacts)
+
+    // 休眠: 接触在一起的物体构成一个岛, 岛内所有物体的速度都持续低于 sleep_speed 达到 time_to_sleep 秒后整岛休眠,
+    // 其中任何一个被碰到或被修改时整岛一起唤醒。
+    std::vector<size_t> m_island_parent;
+    std::vector<bool> m_island_awake;
+    std::vector<PhysicalObject *> m_touched_sleepers;
+    std::vector<PhysicalObject *> m_neighbours;
+    std::vector<PhysicalObject *> m_wake_stack;
+    std::vector<CollisionBox *> m_touching;
+    static constexpr float CONTACT_MARGIN = 0.5f;
+
+    CLASS_PROPERTY(bool, sleep_enabled)
+    CLASS_PROPERTY(float, sleep_speed)
+    CLASS_PROPERTY(float, time_to_sleep)
+
+    CLASS_PROPERTY(bool, fixed_step)
+    CLASS_PROPERTY(int, max_steps_per_frame)
+    CLASS_READONLY_PROPERTY(int, frame_steps)     // 最近一次 on_frame 实际执行的步数
+    CLASS_READONLY_PROPERTY(float, dropped_time) // 最近一次 on_frame 因步数上限丢弃的时间
+
+    // 确定性模式: on_frame 总是按固定 tick 步进 (步长与渲染帧率无关), 并在每步结束时计算所有物体状态的哈希。
+    // 相同的初始状态与相同的逐 tick 输入在任何线程数、任何内存布局下得到逐位相同的结果,
+    // 联机或回放时比较同一 tick 的哈希即可在出现分歧的那一步发现不同步。
+    CLASS_PROPERTY(bool, deterministic)
+    CLASS_READONLY_PROPERTY(uint64_t, step_count) // 已执行的 on_update 次数
+    CLASS_READONLY_PROPERTY(uint64_t, state_hash) // 确定性模式下最近一步结束时的状态哈希
+
+    // 最近一次 on_update 的计数与各阶段耗时; 开启 log_stats 时每步结束后输出到 std::clog。
+    PhysicsStats m_stats;
+    CLASS_PROPERTY(bool, log_stats)
+
+    // 时间预算: 一步耗时超过 time_budget 毫秒 (0 表示不限制) 后, 下一步按 PhysicsDegradation 的顺序多启用一级降级,
+    // 耗时低于预算一半时恢复一级; 降级期间本步已经超时的话剩余的碰撞事件直接丢弃, 宁可损失精度也不拖慢帧率。
+    // 第三级冻结与 active_region 不相交的物体 (通常设为略大于相机视野的区域), 它们保留速度,
+    // 回到区域内、被碰到或者负载降低后继续模拟; active_region 为空时这一级不起作用。
+    // 确定性模式下不启用, 否则模拟结果会取决于机器的快慢。
+    CLASS_PROPERTY(float, time_budget)
+    CLASS_PROPERTY(Rect, active_region)
+    CLASS_READONLY_PROPERTY(int, degrade_level) // 下一步将要使用的降级级数, 0 到 MAX_DEGRADE_LEVEL
+    std::vector<PhysicalObject *> m_frozen;
+    static constexpr int MAX_DEGRADE_LEVEL = 3;
+    static constexpr int BUDGET_CHECK_INTERVAL = 32; // 处理多少个碰撞事件检查一次耗时
+
+private:
+    PhysicsManager(World &world, const Rect &bound)
+        : m_world(&world),
+          m_sweep_tree(bound),
+          m_velocity_iterations(8),
+          m_position_iterations(3),
+          m_restitution_threshold(50.0f),
+          m_speculative_contacts(false),
+          m_sleep_enabled(true),
+          m_sleep_speed(20.0f),
+          m_time_to_sleep(0.5f),
+          m_fixed_step(false),
+          m_max_steps_per_frame(5),
+          m_frame_steps(0),
+          m_dropped_time(0),
+          m_deterministic(false),
+          m_step_count(0),
+          m_state_hash(0),
+          m_log_stats(false),
+          m_time_budget(0),
+          m_degrade_level(0)
+    {
+    }
+
+public:
     ~PhysicsManager();
 
 public:
+    World &world() { return *m_world; }
+
     size_t size() const { return objs.size(); }
     void clear();
 
+    // 所有物体, 前 get_awake_count() 个处于活动状态。
     std::vector<PhysicalObject *> &objects() { return objs; }
     const std::vector<PhysicalObject *> &objects() const { return objs; }
+    size_t get_awake_count() const { return m_awake_count; }
 
-public:
-    void resolve_all_penetrations();
+    // 唤醒物体以及与它接触的所有休眠物体。
+    void wake_up(PhysicalObject *);
+    // 唤醒与区域接触或重叠的休眠物体; 移动或删除障碍物时会自动调用, 修改网格格子后需要手动调用。
+    void wake_in(const Rect &);
+
+    RigidBodyStore &bodies() { return m_bodies; }
+    const RigidBodyStore &bodies() const { return m_bodies; }
+
+    // 最近一次 on_update 处理的碰撞数, 单帧的开销与它成正比。
+    size_t get_impact_count() const { return m_impact_count; }
+    const PhysicsStats &get_stats() const { return m_stats; }
+
+    // 0 或 1 表示串行; 大于 1 时在 worker_count - 1 个工作线程加调用线程上并行, 结果与串行完全一致。
+    void set_worker_count(size_t);
+    size_t get_worker_count() const { return m_pool ? m_pool->chunk_count() : 1; }
+
+    float get_tick_rate() const { return 1.0f / m_tick; }
+    void set_tick_rate(float hz) { m_tick = 1.0f / std::max(hz, 1.0f); }
+
+    // 累积器中不足一个 tick 的剩余时间占比, 渲染时用它在上一步与当前状态之间插值。
+    float get_interpolation_alpha() const { return uses_fixed_step() ? m_accumulator / m_tick : 1.0f; }
+    Rect interpolated_rect(const PhysicalObject &) const;
+
+    // 所有动态物体的位置、尺寸、速度与休眠状态的哈希, 只取决于浮点数的位模式和碰撞盒 id,
+    // 与物体在内部数组中的排列顺序无关。
+    uint64_t compute_state_hash() const;
+
+    // 保存与恢复所有动态物体的状态。out 可以重复使用, 容量足够时不分配内存。
+    // 保存后创建或删除过物体时 restore 不做任何修改并返回 false。
+    PhysicsSnapshot snapshot() const;
+    void snapshot(PhysicsSnapshot &out) const;
+    bool restore(const PhysicsSnapshot &);
 
 private:
-    void handle_collision(CollisionBox &src, CollisionBox *dst);
+    bool uses_fixed_step() const { return m_fixed_step || m_deterministic; }
+
+    void schedule(PhysicalObject *);
+    void schedule_all();
+    void update_sweep(PhysicalObject *);
+    void predict(PhysicalObject *, const QuadTree<CollisionBox> &static_tree, PredictBuffer &) const;
+    void push_events(PredictBuffer &);
+
+    void advance_to(PhysicalObject *, float time);
+    // 把活动物体分块交给 func, 物体较少或没有工作线程时在调用线程上一次处理完。
+    void for_each_awake_range(const ThreadPool::RangeTask &func);
+    void handle_impact(const ImpactEvent &);
+    void drop_events();
+
+    void collect_contacts();
+    void collect_tile_contacts(size_t index);
+
+    // 物体构造与析构时登记和注销, 维持 objs 与 m_bodies 的下标一致。
+    void attach(PhysicalObject *);
+    void detach(PhysicalObject *);
+    void swap_bodies(size_t, size_t);
+    void find_touching(PhysicalObject *, const Rect &area, std::vector<PhysicalObject *> &out);
+    void wake_touched();
+    void update_sleep(float delta);
+
+    void thaw_frozen(bool keep_outside);
+    void freeze_outside();
+    size_t find_island(size_t);
 };
 
 #endif // INCLUDE_PHYSICS_MANAGER
\ No newline at end of file
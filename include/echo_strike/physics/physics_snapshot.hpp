@@ -0,0 +1,72 @@
+#ifndef INCLUDE_PHYSICS_SNAPSHOT
+#define INCLUDE_PHYSICS_SNAPSHOT
+
+#include <echo_strike/physics/object.hpp>
+#include <echo_strike/physics/movement_controller.hpp>
+#include <echo_strike/physics/contact_solver.hpp>
+#include <echo_strike/collision/collision_layer.hpp>
+#include <echo_strike/collision/collision_shape.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/utils/vec2.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class PhysicalObject;
+class PhysicsManager;
+
+/*
+    PhysicsManager 某一时刻的状态, 用于回滚联机和 AI 预演: 保存后模拟若干步, 再恢复并重新模拟。
+    刚体存储的各字段依次排在一块连续的 float 缓冲区中, 其余的单物体状态是一个平铺的结构体数组,
+    保存和恢复都只是整块拷贝, 不创建也不删除任何对象; 重复使用同一个快照时不再分配内存。
+    动态物体碰撞盒的开关、形状和层也一并保存 (目标层按掩码保存, 不复制集合);
+    休眠和冻结的物体碰撞盒一直留在碰撞索引中, 恢复时随矩形同步到保存时的位置。
+    快照只对保存时的那一组动态物体有效, 之后创建或删除过物体就不能再恢复。障碍物和网格不在其中。
+*/
+class PhysicsSnapshot
+{
+    friend PhysicsManager;
+
+private:
+    struct BodyRecord
+    {
+        PhysicalObject *object;
+        Rect prev_rect; // 渲染插值的起点
+        Vec2 move_dir;
+        MovementController move_ctrl;
+        Object::MotionType motion_type;
+        Rect boundary;
+        float mass;
+        float restitution;
+        float sleep_time;
+        bool sleeping;
+        bool frozen;
+        bool box_enable;
+        ShapeType box_shape;
+        CollisionLayer box_src;
+        CollisionLayerMask box_dst;
+    };
+
+    std::vector<float> m_bodies;        // RigidBodyStore::save 的结果
+    std::vector<BodyRecord> m_records;  // 与 m_bodies 中的物体顺序相同
+    std::vector<ContactSolver::Contact> m_contacts; // 热启动用的上一步接触
+    size_t m_end_id = 0;                // 保存时所有物体碰撞盒 id 的上界
+    size_t m_awake_count = 0;
+    float m_accumulator = 0;
+    uint64_t m_step_count = 0;
+    uint64_t m_state_hash = 0;
+
+public:
+    size_t size() const { return m_records.size(); }
+    bool empty() const { return m_records.empty(); }
+
+    // 占用的字节数 (不含容器本身)。
+    size_t byte_size() const
+    {
+        return m_bodies.size() * sizeof(float) + m_records.size() * sizeof(BodyRecord) +
+               m_contacts.size() * sizeof(ContactSolver::Contact);
+    }
+};
+
+#endif // INCLUDE_PHYSICS_SNAPSHOT
@@ -0,0 +1,25 @@
+#include <echo_strike/physics/physics_stats.hpp>
+
+#include <ios>
+#include <ostream>
+
+std::ostream &operator<<(std::ostream &os, const PhysicsStats &stats)
+{
+    os << "physics: " << stats.total_ms << " ms, awake " << stats.awake_bodies
+       << " | ccd " << stats.ccd_ms << " ms: predictions " << stats.predictions
+       << ", candidates " << stats.broadphase_candidates
+       << ", tests " << stats.narrowphase_tests
+       << ", impacts " << stats.impacts
+       << ", stale " << stats.stale_events
+       << ", limit hits " << stats.impact_limit_hits
+       << " | contacts " << stats.contacts_ms << " ms: " << stats.contacts
+       << " x" << stats.velocity_iterations
+       << " | positions " << stats.positions_ms << " ms: x" << stats.position_iterations
+       << ", tiles " << stats.tile_corrections
+       << " | wake " << stats.wake_ms << " ms, forces " << stats.forces_ms
+       << " ms, advance " << stats.advance_ms << " ms, sleep " << stats.sleep_ms << " ms";
+    if (stats.degradations)
+        os << " | degraded 0x" << std::hex << stats.degradations << std::dec
+           << ": dropped " << stats.dropped_events << ", frozen " << stats.frozen_bodies;
+    return os;
+}
@@ -0,0 +1,66 @@
+#ifndef INCLUDE_PHYSICS_STATS
+#define INCLUDE_PHYSICS_STATS
+
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+
+// 单步耗时超过 PhysicsManager 的时间预算时, 按这个顺序逐级启用的降级措施。
+enum class PhysicsDegradation
+{
+    CapImpacts,       // 降低每个物体每步的碰撞次数上限; 本步已经超时的话剩余的碰撞事件直接丢弃
+    ReduceIterations, // 减少速度与位置迭代次数
+    FreezeOffscreen   // 冻结活动区域以外的物体
+};
+
+// 每种降级措施占一位。
+using PhysicsDegradationMask = std::uint32_t;
+
+constexpr PhysicsDegradationMask degradation_bit(PhysicsDegradation degradation)
+{
+    return PhysicsDegradationMask(1) << static_cast<unsigned>(degradation);
+}
+
+/*
+    一次物理步进的统计, 由 PhysicsManager::on_update 在每步开始时清零并填写。
+    计数与线程数无关; 耗时按阶段划分, 单位为毫秒。
+    帧级别的信息 (本帧步数、因步数上限丢弃的时间) 见 PhysicsManager::get_frame_steps / get_dropped_time。
+*/
+struct PhysicsStats
+{
+    size_t awake_bodies = 0;
+
+    // 连续碰撞检测
+    size_t predictions = 0;           // 碰撞时间查询次数, 每个物体每次 (重新) 预测算一次
+    size_t broadphase_candidates = 0; // 扫掠树和静态索引返回的候选总数
+    size_t narrowphase_tests = 0;     // 通过层过滤、实际计算了碰撞时间的物体对
+    size_t impacts = 0;               // 处理的碰撞事件, 即事件驱动下的子步数
+    size_t stale_events = 0;          // 出队时已经过期而丢弃的事件
+    size_t impact_limit_hits = 0;     // 本步碰撞次数达到上限、不再预测的物体数
+
+    // 接触求解与穿透修正
+    size_t contacts = 0;
+    int velocity_iterations = 0;
+    int position_iterations = 0; // 实际执行的位置迭代, 没有重叠时提前结束
+    size_t tile_corrections = 0; // 与网格穿透而被推出的物体数
+
+    // 时间预算
+    PhysicsDegradationMask degradations = 0; // 本步采取的降级措施
+    size_t dropped_events = 0;               // 因本步超时而丢弃的碰撞事件
+    size_t frozen_bodies = 0;                // 本步结束时被冻结的物体数
+
+    // 各阶段耗时
+    double wake_ms = 0;      // 唤醒被碰到的休眠物体
+    double forces_ms = 0;    // 按力更新速度
+    double contacts_ms = 0;  // 收集接触与速度迭代
+    double ccd_ms = 0;       // 预测与处理碰撞事件
+    double advance_ms = 0;   // 推进到帧末
+    double positions_ms = 0; // 位置迭代、网格穿透修正与同步碰撞盒
+    double sleep_ms = 0;     // 休眠判定
+    double total_ms = 0;
+};
+
+// 单行输出, 便于逐步记录到日志。
+std::ostream &operator<<(std::ostream &, const PhysicsStats &);
+
+#endif // INCLUDE_PHYSICS_STATS
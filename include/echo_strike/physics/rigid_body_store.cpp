@@ -0,0 +1,239 @@
+#include <echo_strike/physics/rigid_body_store.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define RIGID_BODY_STORE_SSE2
+#include <emmintrin.h>
+#endif
+
+static constexpr float k_infinity = std::numeric_limits<float>::infinity();
+
+size_t RigidBodyStore::create(PhysicalObject *owner)
+{
+    m_x.push_back(0), m_y.push_back(0), m_w.push_back(0), m_h.push_back(0);
+    m_vx.push_back(0), m_vy.push_back(0);
+    m_fx.push_back(0), m_fy.push_back(0);
+    m_inv_mass.push_back(1);
+    m_time.push_back(0);
+    m_min_x.push_back(-k_infinity), m_min_y.push_back(-k_infinity);
+    m_max_x.push_back(k_infinity), m_max_y.push_back(k_infinity);
+    m_owners.push_back(owner);
+    return m_owners.size() - 1;
+}
+
+/**
+ * @brief 删除一个物体: 把最后一个物体搬到它的位置, 数组保持紧凑。
+ */
+void RigidBodyStore::destroy(size_t index)
+{
+    size_t last = size() - 1;
+    if (index != last)
+    {
+        auto move_last = [&](std::vector<float> &field)
+        { field[index] = field[last]; };
+
+        move_last(m_x), move_last(m_y), move_last(m_w), move_last(m_h);
+        move_last(m_vx), move_last(m_vy);
+        move_last(m_fx), move_last(m_fy);
+        move_last(m_inv_mass);
+        move_last(m_time);
+        move_last(m_min_x), move_last(m_min_y), move_last(m_max_x), move_last(m_max_y);
+
+        m_owners[index] = m_owners[last];
+        m_owners[index]->m_handle = index;
+    }
+
+    for (auto *field : {&m_x, &m_y, &m_w, &m_h, &m_vx, &m_vy, &m_fx, &m_fy,
+                        &m_inv_mass, &m_time, &m_min_x, &m_min_y, &m_max_x, &m_max_y})
+        field->pop_back();
+    m_owners.pop_back();
+}
+
+void RigidBodyStore::swap(size_t a, size_t b)
+{
+    if (a == b)
+        return;
+
+    for (auto *field : {&m_x, &m_y, &m_w, &m_h, &m_vx, &m_vy, &m_fx, &m_fy,
+                        &m_inv_mass, &m_time, &m_min_x, &m_min_y, &m_max_x, &m_max_y})
+        std::swap((*field)[a], (*field)[b]);
+
+    std::swap(m_owners[a], m_owners[b]);
+    m_owners[a]->m_handle = a;
+    m_owners[b]->m_handle = b;
+}
+
+void RigidBodyStore::save(std::vector<float> &buffer) const
+{
+    size_t n = size();
+    buffer.resize(n * 13);
+
+    float *out = buffer.data();
+    for (auto *field : {&m_x, &m_y, &m_w, &m_h, &m_vx, &m_vy, &m_fx, &m_fy,
+                        &m_inv_mass, &m_min_x, &m_min_y, &m_max_x, &m_max_y})
+        out = std::copy(field->begin(), field->end(), out);
+}
+
+void RigidBodyStore::load(const std::vector<float> &buffer, const std::vector<PhysicalObject *> &owners)
+{
+    size_t n = owners.size();
+
+    const float *in = buffer.data();
+    for (auto *field : {&m_x, &m_y, &m_w, &m_h, &m_vx, &m_vy, &m_fx, &m_fy,
+                        &m_inv_mass, &m_min_x, &m_min_y, &m_max_x, &m_max_y})
+    {
+        field->assign(in, in + n);
+        in += n;
+    }
+    m_time.assign(n, 0.0f);
+
+    m_owners = owners;
+    for (size_t i = 0; i < n; ++i)
+        m_owners[i]->m_handle = i;
+}
+
+void RigidBodyStore::set_rect(size_t index, const Rect &rect)
+{
+    m_x[index] = rect.get_x();
+    m_y[index] = rect.get_y();
+    m_w[index] = rect.get_width();
+    m_h[index] = rect.get_height();
+}
+
+void RigidBodyStore::set_speed(size_t index, const Vec2 &speed)
+{
+    m_vx[index] = speed.get_x();
+    m_vy[index] = speed.get_y();
+}
+
+void RigidBodyStore::set_force(size_t index, const Vec2 &force)
+{
+    m_fx[index] = force.get_x();
+    m_fy[index] = force.get_y();
+}
+
+void RigidBodyStore::set_boundary(size_t index, const Rect &boundary)
+{
+    m_min_x[index] = boundary.left();
+    m_min_y[index] = boundary.bottom();
+    m_max_x[index] = boundary.right();
+    m_max_y[index] = boundary.top();
+}
+
+void RigidBodyStore::clear_boundary(size_t index)
+{
+    m_min_x[index] = m_min_y[index] = -k_infinity;
+    m_max_x[index] = m_max_y[index] = k_infinity;
+}
+
+void RigidBodyStore::reset_time(size_t count)
+{
+    std::fill(m_time.begin(), m_time.begin() + count, 0.0f);
+}
+
+/**
+ * @brief 速度加上 力 * 逆质量 * dt。
+ * 每一步开始时先更新速度、再在整步内按不变的速度移动 (半隐式欧拉): 一步内的轨迹是直线,
+ * 与连续碰撞检测的预测一致; 先移动后加速的显式欧拉在反复弹跳中会不断增加能量, 物体永远停不下来。
+ */
+void RigidBodyStore::apply_forces(size_t begin, size_t end, float dt)
+{
+    float *vx = m_vx.data(), *vy = m_vy.data();
+    const float *fx = m_fx.data(), *fy = m_fy.data(), *inv_mass = m_inv_mass.data();
+
+    size_t i = begin;
+
+#ifdef RIGID_BODY_STORE_SSE2
+    const __m128 step = _mm_set1_ps(dt);
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 im = _mm_loadu_ps(inv_mass + i);
+        __m128 sx = _mm_add_ps(_mm_loadu_ps(vx + i), _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(fx + i), im), step));
+        __m128 sy = _mm_add_ps(_mm_loadu_ps(vy + i), _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(fy + i), im), step));
+        _mm_storeu_ps(vx + i, sx), _mm_storeu_ps(vy + i, sy);
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        vx[i] = vx[i] + fx[i] * inv_mass[i] * dt;
+        vy[i] = vy[i] + fy[i] * inv_mass[i] * dt;
+    }
+}
+
+/**
+ * @brief 按当前速度移动到 end_time, 越过边界时贴到边界上并把该轴速度清零。
+ * 边界按移动后两侧分别判断, 两侧都越界时以右 (上) 侧为准, 与 Object::on_update 一致。
+ * SSE2 路径与标量尾部使用相同的运算顺序, 结果逐位一致, 与物体落在哪一组无关。
+ */
+void RigidBodyStore::advance_range(size_t begin, size_t end, float end_time)
+{
+    float *x = m_x.data(), *y = m_y.data();
+    const float *w = m_w.data(), *h = m_h.data();
+    float *vx = m_vx.data(), *vy = m_vy.data();
+    float *time = m_time.data();
+    const float *min_x = m_min_x.data(), *min_y = m_min_y.data();
+    const float *max_x = m_max_x.data(), *max_y = m_max_y.data();
+
+    size_t i = begin;
+
+#ifdef RIGID_BODY_STORE_SSE2
+    const __m128 t_end = _mm_set1_ps(end_time);
+    const __m128 zero = _mm_setzero_ps();
+
+    auto select = [](__m128 mask, __m128 a, __m128 b)
+    { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); };
+
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 dt = _mm_max_ps(_mm_sub_ps(t_end, _mm_loadu_ps(time + i)), zero);
+
+        __m128 sx = _mm_loadu_ps(vx + i), sy = _mm_loadu_ps(vy + i);
+        __m128 px = _mm_add_ps(_mm_loadu_ps(x + i), _mm_mul_ps(sx, dt));
+        __m128 py = _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(sy, dt));
+
+        __m128 bw = _mm_loadu_ps(w + i), bh = _mm_loadu_ps(h + i);
+        __m128 lo_x = _mm_loadu_ps(min_x + i), hi_x = _mm_loadu_ps(max_x + i);
+        __m128 lo_y = _mm_loadu_ps(min_y + i), hi_y = _mm_loadu_ps(max_y + i);
+
+        __m128 below_x = _mm_cmplt_ps(px, lo_x);
+        __m128 above_x = _mm_cmpgt_ps(_mm_add_ps(px, bw), hi_x);
+        __m128 below_y = _mm_cmplt_ps(py, lo_y);
+        __m128 above_y = _mm_cmpgt_ps(_mm_add_ps(py, bh), hi_y);
+
+        px = select(above_x, _mm_sub_ps(hi_x, bw), select(below_x, lo_x, px));
+        py = select(above_y, _mm_sub_ps(hi_y, bh), select(below_y, lo_y, py));
+        sx = _mm_andnot_ps(_mm_or_ps(below_x, above_x), sx);
+        sy = _mm_andnot_ps(_mm_or_ps(below_y, above_y), sy);
+
+        _mm_storeu_ps(x + i, px), _mm_storeu_ps(y + i, py);
+        _mm_storeu_ps(vx + i, sx), _mm_storeu_ps(vy + i, sy);
+        _mm_storeu_ps(time + i, t_end);
+    }
+#endif
+
+    for (; i < end; ++i)
+    {
+        float dt = std::max(end_time - time[i], 0.0f);
+
+        float px = x[i] + vx[i] * dt;
+        float py = y[i] + vy[i] * dt;
+
+        bool below_x = px < min_x[i], above_x = px + w[i] > max_x[i];
+        bool below_y = py < min_y[i], above_y = py + h[i] > max_y[i];
+
+        px = above_x ? max_x[i] - w[i] : (below_x ? min_x[i] : px);
+        py = above_y ? max_y[i] - h[i] : (below_y ? min_y[i] : py);
+        if (below_x || above_x)
+            vx[i] = 0;
+        if (below_y || above_y)
+            vy[i] = 0;
+
+        x[i] = px, y[i] = py;
+        time[i] = end_time;
+    }
+}
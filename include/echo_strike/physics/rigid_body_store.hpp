@@ -0,0 +1,92 @@
+#ifndef INCLUDE_RIGID_BODY_STORE
+#define INCLUDE_RIGID_BODY_STORE
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+
+#include <cstddef>
+#include <vector>
+
+class PhysicalObject;
+class ContactSolver;
+
+/*
+    动态物体的运动状态, 按字段分别存放在连续数组中 (SoA)。
+    积分与边界限制只读写这些数组, 可以一次处理 4 个物体 (SSE2), 不需要逐个访问 PhysicalObject。
+    积分为半隐式欧拉: 一步开始时 apply_forces 更新速度, 之后 advance 按不变的速度移动。
+    PhysicalObject 只保存自己在这里的下标; 删除时与最后一个元素交换, 并更新被移动者的下标。
+*/
+class RigidBodyStore
+{
+    friend ContactSolver;
+
+private:
+    std::vector<float> m_x, m_y, m_w, m_h;
+    std::vector<float> m_vx, m_vy;
+    std::vector<float> m_fx, m_fy;
+    std::vector<float> m_inv_mass;
+    std::vector<float> m_time; // 本帧内已推进到的时刻
+
+    // 边界限制, 不受限制的物体为正负无穷。
+    std::vector<float> m_min_x, m_min_y, m_max_x, m_max_y;
+
+    std::vector<PhysicalObject *> m_owners;
+
+public:
+    RigidBodyStore() = default;
+    ~RigidBodyStore() = default;
+
+    RigidBodyStore(const RigidBodyStore &) = delete;
+    RigidBodyStore &operator=(const RigidBodyStore &) = delete;
+
+public:
+    size_t create(PhysicalObject *owner);
+    void destroy(size_t index);
+
+    // 交换两个物体的位置并更新它们的下标, 用于把活动的物体集中在数组前部。
+    void swap(size_t a, size_t b);
+
+    size_t size() const { return m_owners.size(); }
+    PhysicalObject *owner(size_t index) const { return m_owners[index]; }
+
+    // 把除局部时间以外的所有字段按字段依次拷贝到一块连续的缓冲区。
+    void save(std::vector<float> &buffer) const;
+    // 从 save 的结果恢复, 物体按 owners 的顺序排列并更新各自的下标; owners 必须是当前这组物体。
+    void load(const std::vector<float> &buffer, const std::vector<PhysicalObject *> &owners);
+
+public:
+    Rect rect(size_t index) const { return Rect(m_x[index], m_y[index], m_w[index], m_h[index]); }
+    void set_rect(size_t index, const Rect &rect);
+
+    Vec2 speed(size_t index) const { return Vec2(m_vx[index], m_vy[index]); }
+    void set_speed(size_t index, const Vec2 &speed);
+
+    Vec2 force(size_t index) const { return Vec2(m_fx[index], m_fy[index]); }
+    void set_force(size_t index, const Vec2 &force);
+
+    float inv_mass(size_t index) const { return m_inv_mass[index]; }
+    void set_mass(size_t index, float mass) { m_inv_mass[index] = 1 / mass; }
+
+    void set_boundary(size_t index, const Rect &boundary);
+    void clear_boundary(size_t index);
+
+    float time(size_t index) const { return m_time[index]; }
+    void set_time(size_t index, float time) { m_time[index] = time; }
+    // 把前 count 个物体的局部时间清零。
+    void reset_time(size_t count);
+
+public:
+    // 一步开始时调用: 按力更新 [begin, end) 中物体的速度。
+    void apply_forces(size_t begin, size_t end, float dt);
+
+    // 把一个物体从它的局部时间按当前速度移动到 end_time, 并限制在边界内。
+    void advance(size_t index, float end_time) { advance_range(index, index + 1, end_time); }
+
+    // 把所有物体推进到 end_time, 各自的推进时长可以不同。
+    void advance_all(float end_time) { advance_range(0, size(), end_time); }
+
+    // 以上两个函数只处理 [begin, end) 中的物体; 不同区间互不影响, 可以在不同线程上同时调用。
+    void advance_range(size_t begin, size_t end, float end_time);
+};
+
+#endif // INCLUDE_RIGID_BODY_STORE
@@ -0,0 +1,143 @@
+#ifndef INCLUDE_CAPSULE
+#define INCLUDE_CAPSULE
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/transform/circle.hpp>
+#include <echo_strike/transform/geometry.hpp>
+
+#include <algorithm>
+#include <ostream>
+
+/*
+    胶囊体: 线段 ab 外扩半径 r。
+    二维中两个不相交的线段之间的最近距离总在某个端点处取得,
+    因此下面的相交与扫掠测试都可以化为 "端点 vs 外扩形状" 的闭式计算。
+*/
+class Capsule
+{
+private:
+    Vec2 m_a;
+    Vec2 m_b;
+    float m_radius;
+
+public:
+    Capsule(const Vec2 &a, const Vec2 &b, float r) : m_a(a), m_b(b), m_radius(r) {}
+    Capsule() : Capsule(Vec2(), Vec2(), 0) {}
+
+    // 矩形的内切胶囊体, 轴线沿矩形较长的一边。
+    static Capsule inscribed(const Rect &rect)
+    {
+        Vec2 c = rect.center();
+        float w = rect.get_width(), h = rect.get_height();
+        if (w >= h)
+        {
+            float r = h * 0.5f;
+            return Capsule(Vec2(rect.left() + r, c.get_y()), Vec2(rect.right() - r, c.get_y()), r);
+        }
+
+        float r = w * 0.5f;
+        return Capsule(Vec2(c.get_x(), rect.bottom() + r), Vec2(c.get_x(), rect.top() - r), r);
+    }
+
+public:
+    Vec2 get_a() const { return m_a; }
+    void set_a(const Vec2 &a) { m_a = a; }
+
+    Vec2 get_b() const { return m_b; }
+    void set_b(const Vec2 &b) { m_b = b; }
+
+    float get_radius() const { return m_radius; }
+    void set_radius(float r) { m_radius = r; }
+
+    Rect bounding_box() const
+    {
+        float min_x = std::min(m_a.get_x(), m_b.get_x()) - m_radius;
+        float min_y = std::min(m_a.get_y(), m_b.get_y()) - m_radius;
+        float max_x = std::max(m_a.get_x(), m_b.get_x()) + m_radius;
+        float max_y = std::max(m_a.get_y(), m_b.get_y()) + m_radius;
+        return Rect(min_x, min_y, max_x - min_x, max_y - min_y);
+    }
+
+public:
+    bool is_intersect(const Vec2 &point) const
+    {
+        return distance_sq_point_segment(point, m_a, m_b) <= m_radius * m_radius;
+    }
+    bool is_intersect(const Circle &circle) const
+    {
+        float r = m_radius + circle.get_radius();
+        return distance_sq_point_segment(circle.get_center(), m_a, m_b) <= r * r;
+    }
+    bool is_intersect(const Rect &rect) const
+    {
+        if (is_segment_intersect_rect(m_a, m_b, rect))
+            return true;
+
+        float dist_sq = std::min(distance_sq_point_rect(m_a, rect), distance_sq_point_rect(m_b, rect));
+        for (auto &corner : {rect.top_left(), rect.top_right(), rect.bottom_left(), rect.bottom_right()})
+            dist_sq = std::min(dist_sq, distance_sq_point_segment(corner, m_a, m_b));
+
+        return dist_sq <= m_radius * m_radius;
+    }
+    bool is_intersect(const Capsule &other) const
+    {
+        if (is_segment_intersect(m_a, m_b, other.m_a, other.m_b))
+            return true;
+
+        float dist_sq = std::min(
+            std::min(distance_sq_point_segment(m_a, other.m_a, other.m_b),
+                     distance_sq_point_segment(m_b, other.m_a, other.m_b)),
+            std::min(distance_sq_point_segment(other.m_a, m_a, m_b),
+                     distance_sq_point_segment(other.m_b, m_a, m_b)));
+
+        float r = m_radius + other.m_radius;
+        return dist_sq <= r * r;
+    }
+
+public:
+    float time_to_collide(const Vec2 &velocity, const Rect &target) const
+    {
+        if (is_intersect(target))
+            return 0;
+
+        // 端帽撞上矩形, 或矩形的某个角撞上胶囊体的侧边。
+        float t = min_toi(
+            ray_rounded_rect_toi(m_a, velocity, target, m_radius),
+            ray_rounded_rect_toi(m_b, velocity, target, m_radius));
+
+        Vec2 back = -velocity;
+        for (auto &corner : {target.top_left(), target.top_right(), target.bottom_left(), target.bottom_right()})
+            t = min_toi(t, ray_capsule_toi(corner, back, m_a, m_b, m_radius));
+
+        return t;
+    }
+    float time_to_collide(const Vec2 &velocity, const Circle &target) const
+    {
+        return ray_capsule_toi(target.get_center(), -velocity, m_a, m_b, m_radius + target.get_radius());
+    }
+    float time_to_collide(const Vec2 &velocity, const Capsule &target) const
+    {
+        if (is_intersect(target))
+            return 0;
+
+        float r = m_radius + target.m_radius;
+        Vec2 back = -velocity;
+
+        float t = min_toi(
+            ray_capsule_toi(m_a, velocity, target.m_a, target.m_b, r),
+            ray_capsule_toi(m_b, velocity, target.m_a, target.m_b, r));
+        t = min_toi(t, ray_capsule_toi(target.m_a, back, m_a, m_b, r));
+        t = min_toi(t, ray_capsule_toi(target.m_b, back, m_a, m_b, r));
+
+        return t;
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Capsule &capsule)
+{
+    os << "Capsule(" << capsule.get_a() << ", " << capsule.get_b() << ", " << capsule.get_radius() << ")";
+    return os;
+}
+
+#endif // INCLUDE_CAPSULE
@@ -0,0 +1,74 @@
+#ifndef INCLUDE_CIRCLE
+#define INCLUDE_CIRCLE
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+#include <echo_strike/transform/geometry.hpp>
+
+#include <algorithm>
+#include <ostream>
+
+class Circle
+{
+private:
+    Vec2 m_center;
+    float m_radius;
+
+public:
+    Circle(const Vec2 &c, float r) : m_center(c), m_radius(r) {}
+    Circle(float x, float y, float r) : Circle(Vec2(x, y), r) {}
+    Circle() : Circle(Vec2(), 0) {}
+
+    // 矩形的内切圆, CollisionBox 以此从包围盒得到圆形形状。
+    static Circle inscribed(const Rect &rect)
+    {
+        return Circle(rect.center(), std::min(rect.get_width(), rect.get_height()) * 0.5f);
+    }
+
+public:
+    Vec2 get_center() const { return m_center; }
+    void set_center(const Vec2 &c) { m_center = c; }
+
+    float get_radius() const { return m_radius; }
+    void set_radius(float r) { m_radius = r; }
+
+    Rect bounding_box() const
+    {
+        return Rect(m_center.get_x() - m_radius, m_center.get_y() - m_radius, m_radius * 2, m_radius * 2);
+    }
+
+public:
+    bool is_intersect(const Vec2 &point) const
+    {
+        Vec2 d = point - m_center;
+        return d.dot(d) <= m_radius * m_radius;
+    }
+    bool is_intersect(const Circle &other) const
+    {
+        Vec2 d = other.m_center - m_center;
+        float r = m_radius + other.m_radius;
+        return d.dot(d) <= r * r;
+    }
+    bool is_intersect(const Rect &rect) const
+    {
+        return distance_sq_point_rect(m_center, rect) <= m_radius * m_radius;
+    }
+
+public:
+    float time_to_collide(const Vec2 &velocity, const Circle &target) const
+    {
+        return ray_circle_toi(m_center, velocity, target.m_center, m_radius + target.m_radius);
+    }
+    float time_to_collide(const Vec2 &velocity, const Rect &target) const
+    {
+        return ray_rounded_rect_toi(m_center, velocity, target, m_radius);
+    }
+};
+
+inline std::ostream &operator<<(std::ostream &os, const Circle &circle)
+{
+    os << "Circle(" << circle.get_center() << ", " << circle.get_radius() << ")";
+    return os;
+}
+
+#endif // INCLUDE_CIRCLE
@@ -0,0 +1,162 @@
+#ifndef INCLUDE_GEOMETRY
+#define INCLUDE_GEOMETRY
+
+#include <echo_strike/utils/vec2.hpp>
+#include <echo_strike/transform/rect.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+/*
+    圆形 / 胶囊体碰撞用到的基础几何运算。
+    所有 *_toi 函数都沿用 Rect::time_to_collide 的约定:
+    返回最早的非负碰撞时间, 初始即重叠返回 0, 不会碰撞返回 -1。
+*/
+
+inline float min_toi(float lhs, float rhs)
+{
+    if (lhs < 0)
+        return rhs;
+    if (rhs < 0)
+        return lhs;
+    return std::min(lhs, rhs);
+}
+
+inline Vec2 closest_point_on_segment(const Vec2 &p, const Vec2 &a, const Vec2 &b)
+{
+    Vec2 ab = b - a;
+    float len_sq = ab.dot(ab);
+    if (len_sq < 1e-12f)
+        return a;
+
+    float t = std::clamp((p - a).dot(ab) / len_sq, 0.0f, 1.0f);
+    return a + ab * t;
+}
+
+inline float distance_sq_point_segment(const Vec2 &p, const Vec2 &a, const Vec2 &b)
+{
+    Vec2 d = p - closest_point_on_segment(p, a, b);
+    return d.dot(d);
+}
+
+inline Vec2 closest_point_on_rect(const Vec2 &p, const Rect &rect)
+{
+    return Vec2(
+        std::clamp(p.get_x(), rect.left(), rect.right()),
+        std::clamp(p.get_y(), rect.bottom(), rect.top()));
+}
+
+inline float distance_sq_point_rect(const Vec2 &p, const Rect &rect)
+{
+    Vec2 d = p - closest_point_on_rect(p, rect);
+    return d.dot(d);
+}
+
+inline bool is_segment_intersect(const Vec2 &a, const Vec2 &b, const Vec2 &c, const Vec2 &d)
+{
+    auto orient = [](const Vec2 &p, const Vec2 &q, const Vec2 &r)
+    { return (q - p).cross(r - p); };
+    auto on_segment = [](const Vec2 &p, const Vec2 &q, const Vec2 &r)
+    {
+        return std::min(p.get_x(), q.get_x()) <= r.get_x() && r.get_x() <= std::max(p.get_x(), q.get_x()) &&
+               std::min(p.get_y(), q.get_y()) <= r.get_y() && r.get_y() <= std::max(p.get_y(), q.get_y());
+    };
+
+    float d1 = orient(c, d, a), d2 = orient(c, d, b);
+    float d3 = orient(a, b, c), d4 = orient(a, b, d);
+
+    if (((d1 > 0 && d2 < 0) || (d1 < 0 && d2 > 0)) &&
+        ((d3 > 0 && d4 < 0) || (d3 < 0 && d4 > 0)))
+        return true;
+
+    return (d1 == 0 && on_segment(c, d, a)) ||
+           (d2 == 0 && on_segment(c, d, b)) ||
+           (d3 == 0 && on_segment(a, b, c)) ||
+           (d4 == 0 && on_segment(a, b, d));
+}
+
+// 射线 p + v * t 与矩形的最早相交时间。
+inline float ray_rect_toi(const Vec2 &p, const Vec2 &v, const Rect &rect)
+{
+    return Rect(Point(p), Vec2()).time_to_collide(v, rect);
+}
+
+inline bool is_segment_intersect_rect(const Vec2 &a, const Vec2 &b, const Rect &rect)
+{
+    float t = ray_rect_toi(a, b - a, rect);
+    return t >= 0 && t <= 1;
+}
+
+// 射线 p + v * t 与圆 (c, r) 的最早相交时间, 解 |p + v t - c|^2 = r^2。
+inline float ray_circle_toi(const Vec2 &p, const Vec2 &v, const Vec2 &c, float r)
+{
+    Vec2 m = p - c;
+    float k = m.dot(m) - r * r;
+    if (k <= 0)
+        return 0;
+
+    float a = v.dot(v);
+    float b = m.dot(v);
+    if (a < 1e-12f || b >= 0)
+        return -1;
+
+    float disc = b * b - a * k;
+    if (disc < 0)
+        return -1;
+
+    return (-b - std::sqrt(disc)) / a;
+}
+
+// 射线 p + v * t 与线段 ab 的相交时间, 平行时视为不相交 (由端点处的圆负责)。
+inline float ray_segment_toi(const Vec2 &p, const Vec2 &v, const Vec2 &a, const Vec2 &b)
+{
+    Vec2 e = b - a;
+    float denom = v.cross(e);
+    if (std::abs(denom) < 1e-12f)
+        return -1;
+
+    Vec2 ap = a - p;
+    float t = ap.cross(e) / denom;
+    float u = ap.cross(v) / denom;
+    if (t < 0 || u < 0 || u > 1)
+        return -1;
+
+    return t;
+}
+
+// 射线与胶囊体 (线段 ab 外扩 r) 的最早相交时间: 两端的圆加上两条侧边。
+inline float ray_capsule_toi(const Vec2 &p, const Vec2 &v, const Vec2 &a, const Vec2 &b, float r)
+{
+    if (distance_sq_point_segment(p, a, b) <= r * r)
+        return 0;
+
+    float t = min_toi(ray_circle_toi(p, v, a, r), ray_circle_toi(p, v, b, r));
+
+    Vec2 e = b - a;
+    if (e.length() > 1e-6f)
+    {
+        Vec2 n = Vec2(-e.get_y(), e.get_x()).normalize() * r;
+        t = min_toi(t, ray_segment_toi(p, v, a + n, b + n));
+        t = min_toi(t, ray_segment_toi(p, v, a - n, b - n));
+    }
+
+    return t;
+}
+
+// 射线与圆角矩形 (矩形外扩 r) 的最早相交时间: 横竖两个扩展矩形加上四个角上的圆。
+inline float ray_rounded_rect_toi(const Vec2 &p, const Vec2 &v, const Rect &rect, float r)
+{
+    if (distance_sq_point_rect(p, rect) <= r * r)
+        return 0;
+
+    Rect wide(rect.left() - r, rect.bottom(), rect.get_width() + 2 * r, rect.get_height());
+    Rect tall(rect.left(), rect.bottom() - r, rect.get_width(), rect.get_height() + 2 * r);
+
+    float t = min_toi(ray_rect_toi(p, v, wide), ray_rect_toi(p, v, tall));
+    for (auto &corner : {rect.top_left(), rect.top_right(), rect.bottom_left(), rect.bottom_right()})
+        t = min_toi(t, ray_circle_toi(p, v, corner, r));
+
+    return t;
+}
+
+#endif // INCLUDE_GEOMETRY
@@ -95,6 +95,35 @@ private:
                     child[idx]->query(rect, result);
         }
 
+        // 自连接: 每个值只与同节点中排在其后的值以及祖先节点中的值比较,
+        // 兄弟子树的区域互不相交, 因此每个相交的无序对恰好只会被报告一次。
+        template <typename Func>
+        void query_pairs(std::vector<const Storage *> &ancestors, Func &func) const
+        {
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                auto &cur = values[i];
+
+                for (auto anc : ancestors)
+                    if (anc->pos.is_intersect(cur.pos))
+                        func(anc->value, cur.value);
+
+                for (size_t j = i + 1; j < values.size(); ++j)
+                    if (cur.pos.is_intersect(values[j].pos))
+                        func(cur.value, values[j].value);
+            }
+
+            auto mark = ancestors.size();
+            for (auto &storage : values)
+                ancestors.push_back(&storage);
+
+            for (int idx = 0; idx < 4; ++idx)
+                if (child[idx] != nullptr)
+                    child[idx]->query_pairs(ancestors, func);
+
+            ancestors.resize(mark);
+        }
+
         Storage *find(const Rect &rect, T *val)
         {
             if (!boundary.is_intersect(rect))
@@ -149,26 +178,27 @@ private:
             return nullptr;
         }
 
-        // bool remove(const Rect &rect, T *val)
-        // {
-        //     if (!boundary.is_intersect(rect))
-        //         return false;
-
-        //     for (auto it = values.begin(); it != values.end(); ++it)
-        //     {
-        //         if (it->value == val)
-        //         {
-        //             values.erase(it);
-        //             return true;
-        //         }
-        //     }
-
-        //     for (int idx = 0; idx < 4; ++idx)
-        //         if (child[idx] != nullptr && child[idx]->remove(rect, val))
-        //             return true;
-
-        //     return false;
-        // }
+        // 已知插入时的矩形, 只需搜索与之相交的节点。
+        bool remove(const Rect &rect, T *val)
+        {
+            if (!boundary.is_intersect(rect))
+                return false;
+
+            for (auto it = values.begin(); it != values.end(); ++it)
+            {
+                if (it->value == val)
+                {
+                    values.erase(it);
+                    return true;
+                }
+            }
+
+            for (int idx = 0; idx < 4; ++idx)
+                if (child[idx] != nullptr && child[idx]->remove(rect, val))
+                    return true;
+
+            return false;
+        }
         bool remove(T *val)
         {
             for (auto it = values.begin(); it != values.end(); ++it)
@@ -254,10 +284,24 @@ public:
         return result;
     }
 
+    // 结果追加到调用者提供的缓冲区, 便于在热循环中复用内存。
+    void query(const Rect &rect, std::vector<T *> &result) const
+    {
+        root->query(rect, result);
+    }
+
+    // 枚举树中所有相交的无序对 (a, b), 每对只调用一次 func(a, b)。
+    template <typename Func>
+    void query_pairs(Func &&func) const
+    {
+        std::vector<const Storage *> ancestors;
+        root->query_pairs(ancestors, func);
+    }
+
     Storage *find(const Rect &rect, T *val) { return root->find(rect, val); }
     const Storage *find(const Rect &rect, T *val) const { return root->find(rect, val); }
 
-    // bool remove(const Rect &rect, T *val) { return root->remove(rect, val); }
+    bool remove(const Rect &rect, T *val) { return root->remove(rect, val); }
     bool remove(T *val) { return root->remove(val); }
 
     // void update(const Rect &old_rect, const Rect &new_rect, T *val)
@@ -270,6 +314,14 @@ public:
         if (remove(val))
             insert(rect, val);
     }
+
+    void clear()
+    {
+        auto bound = root->boundary;
+        delete root;
+        root = new Node(1);
+        root->boundary = bound;
+    }
 };
 
 #endif // INCLUDE_QUADTREE
\ No newline at end of file
@@ -0,0 +1,154 @@
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cstdlib>
+#include <cmath>
+
+#include "physics_arena.hpp"
+
+/*
+    无窗口的物理基准测试: 按给定物体数搭建标准场景, 固定 1/60 秒步长运行若干步,
+    输出每步耗时的分位数、每秒处理的物体步数以及平均每步的碰撞数和接触数。
+
+    用法: bench_physics [场景|all] [物体数] [步数] [线程数]
+    场景: rain (粒子雨), pyramid (方块金字塔), pile (密集堆积), bullets (弹幕)
+*/
+
+// 小粒子从不同高度落到地面上, 陆续落地后休眠。
+static void rain(Arena &scene, int count)
+{
+    scene.wall(0, 3990, 4000, 10);
+
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> x_dist(10, 3986), y_dist(0, 3000), speed_dist(-50, 50);
+    for (int i = 0; i < count; ++i)
+        scene.body(Rect(x_dist(rng), y_dist(rng), 4, 4), Vec2(speed_dist(rng), 200), Vec2(0, 1000));
+}
+
+// 紧贴着摆好的方块金字塔, 底层宽度由物体数决定, 检验静止堆叠的稳定性与开销。
+static void pyramid(Arena &scene, int count)
+{
+    scene.wall(0, 3990, 4000, 10);
+
+    int base = 1;
+    while (base * (base + 1) / 2 < count)
+        ++base;
+
+    const float size = 10;
+    int placed = 0;
+    for (int row = 0; row < base && placed < count; ++row)
+        for (int i = 0; i < base - row && placed < count; ++i, ++placed)
+        {
+            float x = 2000 - base * size * 0.5f + row * size * 0.5f + i * size;
+            scene.body(Rect(x, 3990 - (row + 1) * size, size, size), Vec2(), Vec2(0, 1000));
+        }
+}
+
+// 窄容器中从上方落下的大量物体, 互相挤压成密集的一堆。
+static void pile(Arena &scene, int count)
+{
+    float width = std::max(200.0f, std::sqrt(static_cast<float>(count)) * 20);
+    float left = 2000 - width * 0.5f;
+    scene.wall(left - 10, 3990, width + 20, 10);
+    scene.wall(left - 10, 0, 10, 4000);
+    scene.wall(left + width, 0, 10, 4000);
+
+    std::mt19937 rng(2);
+    std::uniform_real_distribution<float> x_dist(left, left + width - 10), y_dist(0, 3000);
+    for (int i = 0; i < count; ++i)
+        scene.body(Rect(x_dist(rng), y_dist(rng), 10, 10), Vec2(), Vec2(0, 1000));
+}
+
+// 封闭场地中没有重力的高速小物体, 不断撞墙和互相碰撞, 全部交给连续碰撞检测。
+static void bullets(Arena &scene, int count)
+{
+    scene.enclose();
+    scene.bullets(count, 3, 800, 1500, 3);
+}
+
+struct Scenario
+{
+    const char *name;
+    void (*setup)(Arena &, int);
+    int default_count;
+};
+
+static const Scenario k_scenarios[] = {
+    {"rain", rain, 5000},
+    {"pyramid", pyramid, 1275},
+    {"pile", pile, 2000},
+    {"bullets", bullets, 2000},
+};
+
+static void run(const Scenario &scenario, int count, int steps, size_t worker_count)
+{
+    Arena scene(4000);
+    auto &physics = scene.physics();
+    physics.set_worker_count(worker_count);
+    scenario.setup(scene, count);
+
+    using Clock = std::chrono::steady_clock;
+    std::vector<double> times;
+    times.reserve(steps);
+    size_t impacts = 0, contacts = 0;
+    for (int i = 0; i < steps; ++i)
+    {
+        auto start = Clock::now();
+        physics.on_update(1.0f / 60);
+        times.push_back(std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+
+        impacts += physics.get_stats().impacts;
+        contacts += physics.get_stats().contacts;
+    }
+
+    double total = 0;
+    for (double t : times)
+        total += t;
+    std::sort(times.begin(), times.end());
+    auto percentile = [&](double p)
+    { return times[std::min(times.size() - 1, static_cast<size_t>(p * times.size()))]; };
+
+    std::cout << std::left << std::setw(9) << scenario.name << std::right
+              << std::setw(7) << physics.size()
+              << std::fixed << std::setprecision(3)
+              << std::setw(9) << total / steps
+              << std::setw(9) << percentile(0.5)
+              << std::setw(9) << percentile(0.95)
+              << std::setw(9) << percentile(0.99)
+              << std::setw(9) << times.back()
+              << std::setprecision(0)
+              << std::setw(13) << physics.size() * steps / (total / 1000)
+              << std::setw(10) << static_cast<double>(impacts) / steps
+              << std::setw(10) << static_cast<double>(contacts) / steps
+              << std::setw(7) << physics.get_awake_count() << '\n';
+    std::cout.unsetf(std::ios::fixed);
+}
+
+int main(int argc, char **argv)
+{
+    std::string which = argc > 1 ? argv[1] : "all";
+    int count = argc > 2 ? std::atoi(argv[2]) : 0;
+    int steps = argc > 3 ? std::atoi(argv[3]) : 600;
+    size_t worker_count = argc > 4 ? std::atoi(argv[4]) : 1;
+
+    std::cout << "scenario  bodies   mean ms   p50 ms   p95 ms   p99 ms   max ms  bodies/sec   impacts  contacts  awake\n";
+
+    bool found = false;
+    for (const auto &scenario : k_scenarios)
+        if (which == "all" || which == scenario.name)
+        {
+            run(scenario, count > 0 ? count : scenario.default_count, std::max(steps, 1), worker_count);
+            found = true;
+        }
+
+    if (!found)
+    {
+        std::cerr << "unknown scenario: " << which << '\n';
+        return 1;
+    }
+    return 0;
+}
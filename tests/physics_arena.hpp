@@ -0,0 +1,98 @@
+#ifndef INCLUDE_TEST_PHYSICS_ARENA
+#define INCLUDE_TEST_PHYSICS_ARENA
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*
+    物理测试与基准共用的场地: 边长 size 的正方形世界, 可以用 enclose 围上四面 10 像素厚的墙。
+    scatter 和 bullets 以给定种子在墙内随机放置物体, 同一组参数每次得到相同的场景。
+    析构时先删除管理器创建的物体, 再删除墙, 最后是世界。
+*/
+struct Arena
+{
+    float size;
+    World world;
+    std::vector<std::unique_ptr<ObstacleObject>> walls;
+    std::vector<PhysicalObject *> bodies; // scatter 和 bullets 创建的物体, 按创建顺序
+
+    explicit Arena(float p_size) : size(p_size), world(Rect(0, 0, size, size)) {}
+    ~Arena() { world.physics().clear(); }
+
+    PhysicsManager &physics() { return world.physics(); }
+
+    void wall(float x, float y, float w, float h)
+    {
+        walls.push_back(std::make_unique<ObstacleObject>(world));
+        walls.back()->set_rect(Rect(x, y, w, h));
+    }
+
+    void enclose()
+    {
+        wall(0, 0, size, 10);
+        wall(0, size - 10, size, 10);
+        wall(0, 0, 10, size);
+        wall(size - 10, 0, 10, size);
+    }
+
+    // 墙内的区域。
+    Rect inner() const { return Rect(10, 10, size - 20, size - 20); }
+
+    PhysicalObject *body(const Rect &rect, const Vec2 &speed, const Vec2 &force)
+    {
+        auto *p = world.physics().create_physical_object();
+        p->set_rect(rect);
+        p->set_speed(speed);
+        p->set_force(force);
+        return p;
+    }
+
+    // 边长 body_size 的物体, 速度的两个分量在 [-max_speed, max_speed] 内均匀分布, 受恒定的力 force。
+    // before_each 在创建每个物体之前调用。
+    void scatter(int count, float body_size, float max_speed, const Vec2 &force, unsigned seed,
+                 const std::function<void(int)> &before_each = {})
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos_dist(20, size - 40), speed_dist(-max_speed, max_speed);
+        for (int i = 0; i < count; ++i)
+        {
+            if (before_each)
+                before_each(i);
+            float x = pos_dist(rng), y = pos_dist(rng);
+            float vx = speed_dist(rng), vy = speed_dist(rng);
+            bodies.push_back(body(Rect(x, y, body_size, body_size), Vec2(vx, vy), force));
+        }
+    }
+
+    // 没有重力、方向随机、速率在 [min_speed, max_speed] 内的完全弹性小物体。
+    void bullets(int count, float body_size, float min_speed, float max_speed, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::uniform_real_distribution<float> pos_dist(20, size - 30), angle_dist(0, 6.2831853f),
+            speed_dist(min_speed, max_speed);
+        for (int i = 0; i < count; ++i)
+        {
+            float angle = angle_dist(rng), speed = speed_dist(rng);
+            float x = pos_dist(rng), y = pos_dist(rng);
+            bodies.push_back(body(Rect(x, y, body_size, body_size),
+                                  Vec2(std::cos(angle) * speed, std::sin(angle) * speed), Vec2()));
+            bodies.back()->set_restitution(1);
+        }
+    }
+
+    void run(int steps)
+    {
+        for (int i = 0; i < steps; ++i)
+            world.physics().on_update(1.0f / 60);
+    }
+};
+
+#endif // INCLUDE_TEST_PHYSICS_ARENA
@@ -0,0 +1,110 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cassert>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+
+// 旧的派发方式: 依次尝试 dynamic_cast。
+static int dispatch_by_cast(Object *obj)
+{
+    if (dynamic_cast<ObstacleObject *>(obj))
+        return 1;
+    else if (dynamic_cast<PhysicalObject *>(obj))
+        return 2;
+    return 0;
+}
+
+static int dispatch_by_kind(Object *obj)
+{
+    switch (obj->get_body_kind())
+    {
+    case BodyKind::Obstacle:
+        return 1;
+    case BodyKind::Physical:
+        return 2;
+    default:
+        return 0;
+    }
+}
+
+int main()
+{
+    World world;
+    auto &physics = world.physics();
+
+    // 与 test_quadtree_optimization 相同的粒子场景: 四面墙, 受重力的 15x15 粒子。
+    std::vector<ObstacleObject *> walls;
+    auto make_wall = [&](float x, float y, float w, float h)
+    {
+        walls.push_back(new ObstacleObject(world));
+        walls.back()->set_rect(Rect(x, y, w, h));
+    };
+    make_wall(0, 0, 800, 10);
+    make_wall(0, 590, 800, 10);
+    make_wall(0, 0, 10, 600);
+    make_wall(790, 0, 10, 600);
+
+    std::mt19937 rng(5);
+    std::uniform_real_distribution<float> x_dist(20, 760), y_dist(20, 560), speed_dist(100.0f, 300.0f);
+    for (int i = 0; i < 400; ++i)
+    {
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(x_dist(rng), y_dist(rng), 15, 15));
+        p->set_speed(Vec2(0, -speed_dist(rng)));
+        p->set_force(Vec2(0, 1000));
+    }
+
+    // ---------- 标签与实际类型一致 ----------
+    assert(body_cast<ObstacleObject>(walls[0]) == walls[0]);
+    assert(body_cast<PhysicalObject>(walls[0]) == nullptr);
+    assert(body_cast<PhysicalObject>(physics.objects()[0]) == physics.objects()[0]);
+    assert(body_cast<ObstacleObject>(nullptr) == nullptr);
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    auto start = Clock::now();
+    for (int frame = 0; frame < 120; ++frame)
+        physics.on_update(1.0f / 60);
+    auto scene_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    // ---------- 单独比较派发: 取场景稳定后穿透修正会访问的所有 (物体, 对方) ----------
+    std::vector<Object *> others;
+    for (auto *p : physics.objects())
+        for (auto *box : p->collision_box().process_collide())
+            others.push_back(box->get_object());
+
+    const int rounds = 2000;
+    long long cast_sum = 0, kind_sum = 0;
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (auto *obj : others)
+            cast_sum += dispatch_by_cast(obj);
+    auto cast_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (int r = 0; r < rounds; ++r)
+        for (auto *obj : others)
+            kind_sum += dispatch_by_kind(obj);
+    auto kind_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    assert(cast_sum == kind_sum);
+
+    std::cout << "Particle scene: 400 bodies x 120 frames in " << scene_ms << " ms\n";
+    std::cout << "Dispatch over " << others.size() << " contacts x " << rounds << " rounds:\n";
+    std::cout << "  dynamic_cast chain: " << cast_ms << " ms\n";
+    std::cout << "  body kind switch:   " << kind_ms << " ms\n";
+
+    physics.clear();
+    for (auto wall : walls)
+        delete wall;
+
+    std::cout << "Body kind tests passed!" << std::endl;
+    return 0;
+}
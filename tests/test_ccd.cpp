@@ -0,0 +1,92 @@
+#include <iostream>
+#include <cassert>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+
+static bool inside(const Rect &rect, const Rect &bound)
+{
+    return rect.left() >= bound.left() && rect.right() <= bound.right() &&
+           rect.bottom() >= bound.bottom() && rect.top() <= bound.top();
+}
+
+int main()
+{
+    // ---------- 同一时刻落地的一排物体都被地面挡住 ----------
+    {
+        World world;
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+
+        auto &physics = world.physics();
+        for (int i = 0; i < 50; ++i)
+        {
+            auto *p = physics.create_physical_object();
+            p->set_rect(Rect(20 + i * 15, 100, 10, 10));
+            p->set_speed(Vec2(0, 200));
+            p->set_force(Vec2(0, 1000));
+        }
+
+        for (int frame = 0; frame < 240; ++frame)
+            physics.on_update(1.0f / 60);
+
+        for (auto *p : physics.objects())
+            assert(p->get_rect().top() <= 590.01f);
+        std::cout << "Simultaneous landing: all 50 bodies stayed above the floor\n";
+        physics.clear();
+    }
+
+    // ---------- 高速小物体不会穿过薄墙 ----------
+    {
+        World world;
+        ObstacleObject wall(world);
+        wall.set_rect(Rect(400, 0, 2, 600));
+
+        auto *bullet = world.physics().create_physical_object();
+        bullet->set_rect(Rect(10, 300, 2, 2));
+        bullet->set_speed(Vec2(40000, 0));
+
+        world.physics().on_update(1.0f / 60);
+        assert(bullet->get_rect().right() <= 400.01f);
+        assert(bullet->get_speed().get_x() < 0);
+        assert(world.physics().get_impact_count() == 1);
+        std::cout << "Bullet: bounced off the wall back to x = " << bullet->get_rect().right() << "\n";
+        world.physics().clear();
+    }
+
+    // ---------- 只有相撞的物体参与处理: 远处的一对碰撞不影响其他物体 ----------
+    {
+        World world(Rect(0, 0, 2000, 2000));
+        auto &physics = world.physics();
+
+        auto *left = physics.create_physical_object();
+        left->set_rect(Rect(100, 100, 10, 10));
+        left->set_speed(Vec2(300, 0));
+
+        auto *right = physics.create_physical_object();
+        right->set_rect(Rect(120, 100, 10, 10));
+        right->set_speed(Vec2(-300, 0));
+
+        for (int i = 0; i < 100; ++i)
+        {
+            auto *p = physics.create_physical_object();
+            p->set_rect(Rect(100 + (i % 10) * 150.0f, 500 + (i / 10) * 120.0f, 10, 10));
+            p->set_speed(Vec2(10, 0));
+        }
+
+        physics.on_update(1.0f / 60);
+        assert(physics.get_impact_count() == 1);
+        assert(left->get_speed().get_x() < 0 && right->get_speed().get_x() > 0);
+        assert(left->get_rect().right() <= right->get_rect().left() + 0.01f);
+
+        for (auto *p : physics.objects())
+            assert(inside(p->get_rect(), Rect(0, 0, 2000, 2000)));
+        std::cout << "Head-on pair among 100 free bodies: " << physics.get_impact_count() << " impact\n";
+        physics.clear();
+    }
+
+    std::cout << "CCD tests passed!" << std::endl;
+    return 0;
+}
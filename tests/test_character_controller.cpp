@@ -0,0 +1,172 @@
+#include <iostream>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/collision/tile_collision_map.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+#include <echo_strike/physics/character_controller.hpp>
+
+static bool near(float a, float b) { return std::abs(a - b) < 1e-3f; }
+
+int main()
+{
+    // ---------- 障碍物: 斜着撞墙时沿墙滑动, 高速也不会穿过薄墙 ----------
+    {
+        World world;
+        auto &collision = world.collision();
+        ObstacleObject wall(world), floor(world);
+        wall.set_rect(Rect(200, 0, 2, 600));
+        floor.set_rect(Rect(0, 500, 800, 100));
+        size_t box_count = collision.size();
+
+        CharacterController controller;
+        Rect rect(150, 300, 20, 40);
+        auto contact = controller.move(collision, rect, Vec2(100, 50), false);
+        assert(contact.right && !contact.floor);
+        assert(near(rect.right(), 200) && near(rect.get_y(), 350));
+
+        rect = Rect(0, 300, 20, 40);
+        contact = controller.move(collision, rect, Vec2(5000, 0), false);
+        assert(contact.right && near(rect.right(), 200));
+
+        // 落地, 之后静止站立 (本帧没有竖直位移) 也判定为站在地面上
+        contact = controller.move(collision, rect, Vec2(0, 1000), false);
+        assert(contact.floor && near(rect.top(), 500));
+        contact = controller.move(collision, rect, Vec2(-30, 0), true);
+        assert(contact.floor && !contact.left && near(rect.top(), 500));
+
+        // 头顶被挡住
+        Rect low(300, 200, 20, 40);
+        ObstacleObject ceiling(world);
+        ceiling.set_rect(Rect(250, 100, 200, 20));
+        contact = controller.move(collision, low, Vec2(0, -500), false);
+        assert(contact.ceiling && near(low.bottom(), 120));
+
+        // 只看静态几何: 不创建碰撞盒, 也不进入物理步进
+        assert(collision.size() == box_count + 1 && world.physics().size() == 0);
+    }
+
+    // ---------- 台阶: 低于 step_height 的直接走上去, 更高的挡住; 只在站在地面上时生效 ----------
+    {
+        World world;
+        auto &collision = world.collision();
+        ObstacleObject floor(world), step(world), wall(world);
+        floor.set_rect(Rect(0, 500, 800, 100));
+        step.set_rect(Rect(200, 492, 100, 8));
+        wall.set_rect(Rect(400, 470, 20, 30));
+
+        CharacterController controller;
+        controller.set_step_height(10);
+
+        Rect rect(170, 460, 20, 40);
+        auto contact = controller.move(collision, rect, Vec2(30, 1), true);
+        assert(contact.stepped && contact.floor && !contact.right);
+        assert(near(rect.get_x(), 200) && near(rect.top(), 492));
+
+        // 在空中时不走台阶
+        Rect airborne(170, 460, 20, 40);
+        contact = controller.move(collision, airborne, Vec2(30, 0), false);
+        assert(!contact.stepped && contact.right && near(airborne.right(), 200));
+
+        // ---------- 贴地: 走下台阶时向下吸附, 没有变成腾空 ----------
+        controller.set_snap_distance(10);
+        contact = controller.move(collision, rect, Vec2(100, 0), true);
+        assert(contact.floor && contact.snapped && near(rect.top(), 500));
+
+        // 起跳时 (向上的位移) 不吸附
+        Rect jumper(320, 460, 20, 40);
+        contact = controller.move(collision, jumper, Vec2(0, -5), true);
+        assert(!contact.floor && near(jumper.top(), 495));
+
+        // 墙高于台阶高度, 挡住
+        contact = controller.move(collision, rect, Vec2(200, 1), true);
+        assert(contact.right && !contact.stepped && near(rect.right(), 400));
+    }
+
+    // ---------- 网格: 阶梯状的格子一级一级走上去, 单向平台只在下落时阻挡 ----------
+    {
+        World world;
+        auto &collision = world.collision();
+        auto &tiles = collision.create_tile_map(Point(0, 0), 10, 80, 60);
+        tiles.fill(0, 50, 80, 10, TileType::Solid);
+        for (int i = 0; i < 5; ++i)
+            tiles.fill(20 + i, 49 - i, 60 - i, 1, TileType::Solid);
+        tiles.fill(5, 40, 5, 1, TileType::OneWay);
+
+        CharacterController controller;
+        controller.set_step_height(10);
+        controller.set_snap_distance(10);
+
+        Rect rect(150, 480, 8, 20);
+        bool on_floor = true;
+        for (int frame = 0; frame < 60; ++frame)
+        {
+            auto contact = controller.move(collision, rect, Vec2(5, 1), on_floor);
+            on_floor = contact.floor;
+            assert(on_floor);
+        }
+        assert(near(rect.top(), 450) && rect.get_x() > 250);
+
+        // 从单向平台下方跳上去, 落在平台上
+        Rect jumper(60, 480, 8, 20);
+        auto contact = controller.move(collision, jumper, Vec2(0, -100), true);
+        assert(!contact.ceiling && near(jumper.get_y(), 380));
+        contact = controller.move(collision, jumper, Vec2(0, 50), false);
+        assert(contact.floor && near(jumper.top(), 400));
+    }
+
+    // ---------- 层掩码: 不在 collision_mask 中的障碍物不阻挡 ----------
+    {
+        World world;
+        auto &collision = world.collision();
+        ObstacleObject wall(world);
+        wall.set_rect(Rect(200, 0, 20, 600));
+        wall.collision_box().set_src(CollisionLayer::Enemy);
+
+        CharacterController controller;
+        Rect rect(150, 300, 20, 40);
+        auto contact = controller.move(collision, rect, Vec2(100, 0), false);
+        assert(!contact.right && near(rect.get_x(), 250));
+
+        controller.set_collision_mask(layer_mask(CollisionLayer::Obstacle, CollisionLayer::Enemy));
+        rect = Rect(150, 300, 20, 40);
+        contact = controller.move(collision, rect, Vec2(100, 0), false);
+        assert(contact.right && near(rect.right(), 200));
+    }
+
+    // ---------- 性能: 大量角色在地面上来回走 ----------
+    {
+        World world(Rect(0, 0, 4000, 4000));
+        auto &collision = world.collision();
+        std::vector<std::unique_ptr<ObstacleObject>> blocks;
+        for (int i = 0; i < 200; ++i)
+        {
+            blocks.push_back(std::make_unique<ObstacleObject>(world));
+            blocks.back()->set_rect(Rect(i * 20.0f, 3990 - (i % 3) * 4.0f, 20, 10 + (i % 3) * 4.0f));
+        }
+
+        const int count = 1000;
+        std::vector<Rect> rects;
+        for (int i = 0; i < count; ++i)
+            rects.push_back(Rect(i * 3.9f, 3950 - (i % 3) * 4.0f, 8, 20));
+
+        CharacterController controller;
+        controller.set_step_height(6);
+        controller.set_snap_distance(6);
+
+        using Clock = std::chrono::high_resolution_clock;
+        auto start = Clock::now();
+        for (int frame = 0; frame < 100; ++frame)
+            for (int i = 0; i < count; ++i)
+                controller.move(collision, rects[i], Vec2(frame < 50 ? 3.0f : -3.0f, 2), true);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / 100;
+        std::cout << count << " characters: " << ms << " ms/frame\n";
+    }
+
+    std::cout << "Character controller tests passed!" << std::endl;
+    return 0;
+}
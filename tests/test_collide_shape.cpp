@@ -0,0 +1,147 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <random>
+
+#include <echo_strike/collision/collision_shape.hpp>
+
+static bool near(float a, float b) { return std::abs(a - b) < 1e-3f; }
+
+static Rect moved(const Rect &rect, const Vec2 &velocity, float t)
+{
+    return Rect(rect.get_x() + velocity.get_x() * t, rect.get_y() + velocity.get_y() * t, rect.get_width(), rect.get_height());
+}
+
+static Rect expanded(const Rect &rect, float margin)
+{
+    return Rect(rect.get_x() - margin, rect.get_y() - margin, rect.get_width() + margin * 2, rect.get_height() + margin * 2);
+}
+
+/**
+ * @brief 随机形状对: 用小步长逐步移动 a, 找到第一次相交的时刻, 与解析的碰撞时间比较。
+ * 两者不一致时只允许是擦边的情况: 把 b 放大或缩小一点点后结论就会改变。
+ * @return 擦边而被放过的次数
+ */
+static int brute_force(int cases, unsigned seed)
+{
+    const ShapeType types[] = {ShapeType::Rect, ShapeType::Circle, ShapeType::Capsule};
+    const int steps = 1000;
+    const float dt = 1.0f / steps, margin = 0.05f;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos(0, 100), size(2, 30), speed(-150, 150);
+    std::uniform_int_distribution<int> type(0, 2);
+
+    int grazing = 0;
+    for (int done = 0; done < cases;)
+    {
+        ShapeType a_type = types[type(rng)], b_type = types[type(rng)];
+        Rect a(pos(rng), pos(rng), size(rng), size(rng));
+        Rect b(pos(rng), pos(rng), size(rng), size(rng));
+        Vec2 v(speed(rng), speed(rng));
+        if (shape_intersect(a_type, a, b_type, b))
+            continue; // 起始时就重叠的不在比较范围内
+        ++done;
+
+        float t = shape_time_to_collide(a_type, a, v, b_type, b);
+        int hit = -1;
+        for (int i = 1; i <= steps && hit < 0; ++i)
+            if (shape_intersect(a_type, moved(a, v, i * dt), b_type, b))
+                hit = i;
+
+        bool agree;
+        if (hit < 0)
+            agree = t < 0 || t > 1 - dt;
+        else
+            agree = t >= (hit - 1) * dt - 1e-4f && t <= hit * dt + 1e-4f;
+        if (agree)
+            continue;
+
+        // 解析结果更早 (或逐步检测漏掉): 在解析时刻, 放大的 b 应当已经接触;
+        // 逐步检测更早 (或解析漏掉): 在逐步检测的时刻, 缩小的 b 应当还没有接触。
+        bool early = t >= 0 && (hit < 0 || t < hit * dt);
+        if (early)
+            assert(t <= 1 && shape_intersect(a_type, moved(a, v, t), b_type, expanded(b, margin)));
+        else
+            assert(!shape_intersect(a_type, moved(a, v, hit * dt), b_type, expanded(b, -margin)));
+        ++grazing;
+    }
+    return grazing;
+}
+
+int main()
+{
+    // 圆 vs 圆: 半径 5 的两个圆, 圆心相距 30, 以 10/s 相向运动 -> 间隙 20, 需要 2s
+    Circle c1(0, 0, 5);
+    Circle c2(30, 0, 5);
+    float t = c1.time_to_collide(Vec2(10, 0), c2);
+    std::cout << "Test 1: circle -> circle\n";
+    std::cout << "Expected collision time: 2.0\n";
+    std::cout << "Computed collision time: " << t << "\n\n";
+    assert(near(t, 2.0f));
+
+    // 圆 vs 矩形: 圆心 (0, 5), 半径 5, 矩形左边在 x = 20 -> 需要移动 15
+    Rect r1(20, 0, 10, 10);
+    t = Circle(0, 5, 5).time_to_collide(Vec2(5, 0), r1);
+    std::cout << "Test 2: circle -> rect face\n";
+    std::cout << "Expected collision time: 3.0\n";
+    std::cout << "Computed collision time: " << t << "\n\n";
+    assert(near(t, 3.0f));
+
+    // 圆 vs 矩形的角: 圆沿对角线撞向角 (20, 20), 只有圆角部分会先接触
+    t = Circle(0, 0, 5).time_to_collide(Vec2(1, 1), Rect(20, 20, 10, 10));
+    float expected = (20 * std::sqrt(2.0f) - 5) / std::sqrt(2.0f);
+    std::cout << "Test 3: circle -> rect corner\n";
+    std::cout << "Expected collision time: " << expected << "\n";
+    std::cout << "Computed collision time: " << t << "\n\n";
+    assert(near(t, expected));
+
+    // 圆擦过矩形角的外侧, 包围盒会相撞但圆不会: 角 (24, 16) 到路径 y = x 的距离约为 5.66
+    assert(Rect(-5, -5, 10, 10).time_to_collide(Vec2(1, 1), Rect(24, 6, 10, 10)) > 0);
+    t = Circle(0, 0, 5).time_to_collide(Vec2(1, 1), Rect(24, 6, 10, 10));
+    assert(t < 0);
+    t = Circle(0, 0, 1).time_to_collide(Vec2(1, 1), Rect(20, -20, 1, 1));
+    std::cout << "Test 4: circle misses rect\n";
+    std::cout << "Expected collision time: -1 (no collision)\n";
+    std::cout << "Computed collision time: " << t << "\n\n";
+    assert(t < 0);
+
+    // 胶囊体 vs 矩形: 竖直胶囊体 (包围盒 10x30) 向右撞墙
+    Capsule cap = Capsule::inscribed(Rect(0, 0, 10, 30));
+    t = cap.time_to_collide(Vec2(10, 0), Rect(40, 10, 10, 10));
+    std::cout << "Test 5: capsule -> rect side\n";
+    std::cout << "Expected collision time: 3.0\n";
+    std::cout << "Computed collision time: " << t << "\n\n";
+    assert(near(t, 3.0f));
+
+    // 胶囊体 vs 矩形: 矩形的角撞上胶囊体的端帽
+    t = cap.time_to_collide(Vec2(0, -10), Rect(0, -20, 10, 10));
+    std::cout << "Test 6: capsule -> rect below\n";
+    std::cout << "Expected collision time: 1.0\n";
+    std::cout << "Computed collision time: " << t << "\n\n";
+    assert(near(t, 1.0f));
+
+    // 相交测试
+    assert(Circle(0, 0, 5).is_intersect(Rect(3, 3, 10, 10)));
+    assert(!Circle(0, 0, 5).is_intersect(Rect(4, 4, 10, 10)));
+    assert(cap.is_intersect(Rect(9, 15, 5, 5)));
+    assert(!cap.is_intersect(Rect(9.5f, 0, 5, 1)));
+    assert(Capsule(Vec2(0, 0), Vec2(10, 0), 1).is_intersect(Capsule(Vec2(5, -5), Vec2(5, 5), 1)));
+
+    // 形状标签派发与直接调用一致, 交换主次时相对速度取反
+    Rect a(0, 0, 10, 10), b(30, 0, 10, 10);
+    assert(near(shape_time_to_collide(ShapeType::Circle, a, Vec2(10, 0), ShapeType::Circle, b), 2.0f));
+    assert(near(shape_time_to_collide(ShapeType::Rect, a, Vec2(10, 0), ShapeType::Circle, b),
+                shape_time_to_collide(ShapeType::Circle, b, Vec2(-10, 0), ShapeType::Rect, a)));
+    assert(shape_intersect(ShapeType::Rect, Rect(0, 0, 10, 10), ShapeType::Rect, Rect(10, 10, 5, 5)));
+    assert(!shape_intersect(ShapeType::Circle, Rect(0, 0, 10, 10), ShapeType::Circle, Rect(10, 10, 5, 5)));
+
+    // 扫掠碰撞与逐步移动的结果一致
+    const int cases = 20000;
+    int grazing = brute_force(cases, 42);
+    std::cout << "Brute-force: " << cases << " random cases, " << grazing << " grazing\n";
+    assert(grazing < cases / 100);
+
+    std::cout << "Shape tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,166 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cassert>
+
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/event/events.hpp>
+#include <echo_strike/event/event_bus.hpp>
+#include <echo_strike/core/world.hpp>
+
+// 旧的派发方式: 每个盒子各做一次宽阶段查询, 同一对会被检测两次。
+static size_t legacy_process_collide(CollisionManager &manager, size_t &queries)
+{
+    size_t checks = 0;
+    for (auto src_box : manager.collision_boxes())
+    {
+        if (!src_box->get_enable() || src_box->get_src() == CollisionLayer::None || src_box->get_dst().empty())
+            continue;
+
+        ++queries;
+        auto dst_boxes = src_box->process_collide();
+        checks += dst_boxes.size();
+        for (auto dst_box : dst_boxes)
+        {
+            if (auto callback = dst_box->get_callback())
+                callback(*src_box);
+        }
+    }
+    return checks;
+}
+
+int main()
+{
+    auto &manager = CollisionManager::instance();
+
+    // ---------- test_collision.cpp 场景: 两个互相关注的盒子 ----------
+    int box1_hits = 0, box2_hits = 0;
+
+    auto &box1 = *manager.create_collision_box();
+    box1.set_rect(Rect{100, 100, 200, 200});
+    box1.set_src(CollisionLayer::Player);
+    box1.add_dst(CollisionLayer::Enemy);
+    box1.on_collide(
+        [&](CollisionBox &)
+        { ++box1_hits; });
+
+    auto &box2 = *manager.create_collision_box();
+    box2.set_rect(Rect{250, 150, 200, 200});
+    box2.set_src(CollisionLayer::Enemy);
+    box2.add_dst(CollisionLayer::Player);
+    box2.on_collide(
+        [&](CollisionBox &)
+        { ++box2_hits; });
+
+    size_t legacy_queries = 0;
+    size_t legacy_checks = legacy_process_collide(manager, legacy_queries);
+    assert(box1_hits == 1 && box2_hits == 1);
+
+    size_t batches = 0, batched_contacts = 0;
+    World::instance().events().subscribe<CollisionBatchEvent>(
+        [&](CollisionBatchEvent *event)
+        {
+            ++batches;
+            batched_contacts += event->get_contacts().size();
+        });
+
+    box1_hits = box2_hits = 0;
+    manager.process_collide();
+    assert(box1_hits == 1 && box2_hits == 1);
+    assert(batches == 1 && batched_contacts == 1);
+
+    std::cout << "Scene test_collision:\n";
+    std::cout << "  legacy: " << legacy_queries << " queries, " << legacy_checks << " pair checks\n";
+    std::cout << "  paired: 1 traversal, " << manager.get_pair_count() << " pair checks\n\n";
+    assert(manager.get_pair_count() * 2 == legacy_checks);
+
+    // ---------- 传感器: 每帧报告一次重叠, 物理查询看不到它 ----------
+    int sensor_hits = 0;
+    auto &sensor = *manager.create_collision_box();
+    manager.set_sensor(&sensor, true);
+    sensor.set_rect(Rect{120, 120, 20, 20});
+    sensor.set_src(CollisionLayer::Enemy);
+    sensor.add_dst(CollisionLayer::Player);
+    sensor.on_collide(
+        [&](CollisionBox &)
+        { ++sensor_hits; });
+
+    box1_hits = box2_hits = 0;
+    manager.process_collide();
+    assert(sensor_hits == 1 && box1_hits == 2 && box2_hits == 1);
+    assert(box1.process_collide().size() == 1);
+    manager.destroy_collision_box(&sensor);
+
+    manager.clear();
+
+    // ---------- 大规模随机场景 ----------
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> pos_dist(0.0f, 780.0f);
+    const int box_count = 2000;
+    const int rounds = 100;
+
+    size_t callbacks = 0;
+    for (int i = 0; i < box_count; ++i)
+    {
+        auto box = manager.create_collision_box();
+        box->set_rect(Rect{pos_dist(rng) * 0.9f, pos_dist(rng) * 0.7f, 12, 12});
+        box->set_src(i % 2 ? CollisionLayer::Player : CollisionLayer::Enemy);
+        box->add_dst(CollisionLayer::Player);
+        box->add_dst(CollisionLayer::Enemy);
+        box->on_collide(
+            [&](CollisionBox &)
+            { ++callbacks; });
+    }
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    size_t legacy_total_checks = 0;
+    legacy_queries = 0;
+    callbacks = 0;
+    auto start = Clock::now();
+    for (int i = 0; i < rounds; ++i)
+        legacy_total_checks += legacy_process_collide(manager, legacy_queries);
+    auto legacy_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    size_t legacy_callbacks = callbacks;
+
+    size_t paired_total_checks = 0;
+    callbacks = 0;
+    start = Clock::now();
+    for (int i = 0; i < rounds; ++i)
+    {
+        manager.process_collide();
+        paired_total_checks += manager.get_pair_count();
+    }
+    auto paired_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    assert(callbacks == legacy_callbacks);
+
+    std::cout << "Scene " << box_count << " boxes x " << rounds << " rounds:\n";
+    std::cout << "  legacy: " << legacy_queries << " queries, " << legacy_total_checks
+              << " pair checks, " << legacy_ms << " ms\n";
+    std::cout << "  paired: " << rounds << " traversals, " << paired_total_checks
+              << " pair checks, " << paired_ms << " ms\n";
+
+    // ---------- 并行窄阶段: 结果与串行完全一致 ----------
+    auto serial_contacts = manager.contacts();
+
+    manager.set_worker_count(std::thread::hardware_concurrency());
+    callbacks = 0;
+    start = Clock::now();
+    for (int i = 0; i < rounds; ++i)
+        manager.process_collide();
+    auto parallel_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    assert(callbacks == legacy_callbacks);
+
+    auto &parallel_contacts = manager.contacts();
+    assert(parallel_contacts.size() == serial_contacts.size());
+    for (size_t i = 0; i < serial_contacts.size(); ++i)
+        assert(parallel_contacts[i].a == serial_contacts[i].a && parallel_contacts[i].b == serial_contacts[i].b);
+
+    std::cout << "  parallel x" << manager.get_worker_count() << ": " << parallel_ms << " ms\n";
+    manager.set_worker_count(1);
+
+    manager.clear();
+    return 0;
+}
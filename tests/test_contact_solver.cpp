@@ -0,0 +1,206 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+
+static void run(PhysicsManager &physics, int frames)
+{
+    for (int frame = 0; frame < frames; ++frame)
+        physics.on_update(1.0f / 60);
+}
+
+// 一列紧贴着叠放在地面上的物体, 从下往上。
+static std::vector<PhysicalObject *> make_stack(PhysicsManager &physics, int height)
+{
+    std::vector<PhysicalObject *> stack;
+    for (int i = 0; i < height; ++i)
+    {
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(100, 580 - i * 10.0f, 10, 10));
+        p->set_force(Vec2(0, 1000));
+        stack.push_back(p);
+    }
+    return stack;
+}
+
+// 相邻两个物体之间最大的重叠量 (像素)。
+static float max_overlap(const std::vector<PhysicalObject *> &stack)
+{
+    float overlap = std::max(stack[0]->get_rect().top() - 590, 0.0f);
+    for (size_t i = 1; i < stack.size(); ++i)
+        overlap = std::max(overlap, stack[i]->get_rect().top() - stack[i - 1]->get_rect().bottom());
+    return overlap;
+}
+
+int main()
+{
+    // ---------- 叠放的一列物体保持静止, 不抖动也不互相压入; 热启动下每步两次迭代也足够 ----------
+    for (int iterations : {8, 2})
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_sleep_enabled(false);
+        physics.set_velocity_iterations(iterations);
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+        auto stack = make_stack(physics, 10);
+
+        run(physics, 600);
+        std::vector<Rect> rects;
+        for (auto *p : stack)
+            rects.push_back(p->get_rect());
+
+        run(physics, 60);
+        for (size_t i = 0; i < stack.size(); ++i)
+        {
+            assert(std::abs(stack[i]->get_rect().get_y() - rects[i].get_y()) < 0.05f);
+            assert(std::abs(stack[i]->get_rect().get_x() - 100) < 1e-3f);
+            assert(stack[i]->get_speed().length() < 0.1f);
+        }
+        assert(max_overlap(stack) < 0.05f);
+        // 静止接触不交给连续碰撞检测
+        assert(physics.get_impact_count() == 0);
+    }
+
+    // ---------- 更高的一列在默认迭代次数下同样能静止 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+        auto stack = make_stack(physics, 20);
+
+        run(physics, 900);
+        assert(physics.get_awake_count() == 0);
+        assert(max_overlap(stack) < 0.5f);
+        assert(stack.back()->get_rect().get_y() < 580 - 19 * 10.0f + 5);
+    }
+
+    // ---------- 恢复系数: 为 0 时落地不反弹, 默认值下按 0.8 反弹 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+
+        auto *dull = physics.create_physical_object();
+        dull->set_rect(Rect(100, 480, 10, 10));
+        dull->set_speed(Vec2(0, 300));
+        dull->set_restitution(0);
+
+        auto *bouncy = physics.create_physical_object();
+        bouncy->set_rect(Rect(200, 480, 10, 10));
+        bouncy->set_speed(Vec2(0, 300));
+        assert(bouncy->get_restitution() == 0.8f);
+
+        run(physics, 30);
+        assert(dull->get_rect().top() > 589.9f);
+        assert(bouncy->get_rect().top() < 580);
+    }
+
+    // ---------- 圆形碰撞盒按形状接触: 包围盒斜向重叠但圆之间有间隙时不推开, 也不减速 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_sleep_enabled(false);
+
+        auto *a = physics.create_physical_object();
+        a->collision_box().set_shape(ShapeType::Circle);
+        a->set_rect(Rect(100, 100, 20, 20));
+        auto *b = physics.create_physical_object();
+        b->collision_box().set_shape(ShapeType::Circle);
+        b->set_rect(Rect(117, 117, 20, 20)); // 包围盒重叠 3x3, 圆心距约 24 > 20
+
+        // 擦过障碍物角落的圆同样不被挡住
+        ObstacleObject corner(world);
+        corner.set_rect(Rect(300, 300, 40, 40));
+        auto *c = physics.create_physical_object();
+        c->collision_box().set_shape(ShapeType::Circle);
+        c->set_rect(Rect(281, 281, 20, 20));
+        c->set_speed(Vec2(0, -30)); // 沿角落向外移动, 包围盒一直与障碍物重叠
+
+        run(physics, 5);
+        assert(a->get_rect() == Rect(100, 100, 20, 20));
+        assert(b->get_rect() == Rect(117, 117, 20, 20));
+        assert(c->get_speed() == Vec2(0, -30));
+        assert(std::abs(c->get_rect().get_x() - 281) < 1e-4f);
+        assert(physics.get_impact_count() == 0);
+    }
+
+    // ---------- 圆形碰撞盒叠放: 法线取圆心连线, 上面的圆停在下面的圆顶上 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_sleep_enabled(false);
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+        auto stack = make_stack(physics, 2);
+        for (auto *p : stack)
+            p->collision_box().set_shape(ShapeType::Circle);
+
+        run(physics, 300);
+        assert(max_overlap(stack) < 0.05f);
+        assert(std::abs(stack[1]->get_rect().get_x() - 100) < 1e-3f);
+        assert(stack[1]->get_speed().length() < 0.1f);
+    }
+
+    // ---------- 性能: 随机落下的一堆物体, 统计静止下来所需的时间与每帧开销 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        std::vector<ObstacleObject *> walls;
+        auto wall = [&](float x, float y, float w, float h)
+        {
+            walls.push_back(new ObstacleObject(world));
+            walls.back()->set_rect(Rect(x, y, w, h));
+        };
+        wall(0, 590, 800, 10);
+        wall(0, 0, 10, 600);
+        wall(790, 0, 10, 600);
+
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> x_dist(20, 770), y_dist(20, 400);
+        for (int i = 0; i < 400; ++i)
+        {
+            auto *p = physics.create_physical_object();
+            p->set_rect(Rect(x_dist(rng), y_dist(rng), 10, 10));
+            p->set_force(Vec2(0, 1000));
+        }
+
+        using Clock = std::chrono::high_resolution_clock;
+        auto start = Clock::now();
+        int frame = 0;
+        while (frame < 1200 && physics.get_awake_count() > 0)
+        {
+            physics.on_update(1.0f / 60);
+            ++frame;
+        }
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        assert(physics.get_awake_count() == 0);
+
+        for (auto *p : physics.objects())
+            assert(p->get_rect().top() <= 590.5f);
+
+        std::cout << "Pile of " << physics.size() << " bodies asleep after " << frame << " frames, "
+                  << ms / frame << " ms/frame\n";
+
+        physics.clear();
+        for (auto w : walls)
+            delete w;
+    }
+
+    std::cout << "Contact solver tests passed!" << std::endl;
+    return 0;
+}
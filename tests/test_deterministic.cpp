@@ -0,0 +1,118 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <random>
+#include <cassert>
+#include <cmath>
+
+#include "physics_arena.hpp"
+
+struct Options
+{
+    size_t worker_count = 1;
+    bool scatter_heap = false; // 在创建物体之间穿插其它分配, 让物体地址与上一次运行不同
+    bool random_frames = false; // 用长短不一的渲染帧驱动 on_frame, 而不是每次一个 tick
+    int nudge_tick = -1;        // 在这个 tick 之前把一个物体挪动一个 ulp
+};
+
+// 四面墙围起的场地中随机运动的物体, 返回第 i 个 tick 结束时的状态哈希。
+static std::vector<uint64_t> simulate(const Options &options, int ticks)
+{
+    Arena arena(2000);
+    auto &physics = arena.physics();
+    physics.set_deterministic(true);
+    physics.set_worker_count(options.worker_count);
+    arena.enclose();
+
+    std::vector<std::unique_ptr<char[]>> garbage;
+    auto scatter_heap = [&](int i)
+    {
+        if (options.scatter_heap)
+            garbage.push_back(std::make_unique<char[]>(16 + i % 7 * 40));
+    };
+    arena.scatter(600, 10, 400, Vec2(0, 600), 5, scatter_heap);
+    auto &bodies = arena.bodies;
+
+    std::vector<uint64_t> hashes;
+    std::mt19937 frame_rng(9);
+    std::uniform_real_distribution<float> frame_dist(0.2f, 2.5f);
+    while (physics.get_step_count() < static_cast<uint64_t>(ticks))
+    {
+        if (static_cast<int>(physics.get_step_count()) == options.nudge_tick)
+        {
+            Rect rect = bodies[17]->get_rect();
+            rect.set_x(std::nextafter(rect.get_x(), 1e9f));
+            bodies[17]->set_rect(rect);
+        }
+
+        if (options.random_frames)
+        {
+            uint64_t before = physics.get_step_count();
+            physics.on_frame(frame_dist(frame_rng) / 60);
+            // 确定性模式下即使没有开启固定步长, 每一步也都是一个 tick
+            assert(physics.get_step_count() - before == static_cast<uint64_t>(physics.get_frame_steps()));
+            if (physics.get_frame_steps() == 0)
+                continue;
+            hashes.resize(physics.get_step_count() - 1, 0); // 同一帧内中间几步的哈希无法观察到
+        }
+        else
+            physics.on_update(1.0f / 60);
+
+        assert(physics.get_state_hash() == physics.compute_state_hash());
+        hashes.push_back(physics.get_state_hash());
+    }
+
+    hashes.resize(ticks);
+    return hashes;
+}
+
+int main()
+{
+    const int ticks = 240;
+    auto reference = simulate(Options{}, ticks);
+
+    // ---------- 哈希随状态变化 ----------
+    assert(reference[0] != reference[1]);
+    assert(reference.front() != reference.back());
+
+    // ---------- 重复运行、改变内存布局、多线程时每个 tick 的哈希都一致 ----------
+    assert(simulate(Options{}, ticks) == reference);
+    {
+        Options options;
+        options.scatter_heap = true;
+        assert(simulate(options, ticks) == reference);
+    }
+    {
+        Options options;
+        options.worker_count = 4;
+        assert(simulate(options, ticks) == reference);
+    }
+
+    // ---------- 渲染帧长短不一时仍按 tick 步进, 结果与逐 tick 调用相同 ----------
+    {
+        Options options;
+        options.random_frames = true;
+        auto hashes = simulate(options, ticks);
+        int compared = 0;
+        for (int i = 0; i < ticks; ++i)
+            if (hashes[i] != 0)
+            {
+                assert(hashes[i] == reference[i]);
+                ++compared;
+            }
+        assert(compared > ticks / 2);
+    }
+
+    // ---------- 一个物体偏移一个 ulp, 在同一个 tick 就能发现不同步 ----------
+    {
+        Options options;
+        options.nudge_tick = 100;
+        auto hashes = simulate(options, ticks);
+        for (int i = 0; i < 100; ++i)
+            assert(hashes[i] == reference[i]);
+        assert(hashes[100] != reference[100]);
+    }
+
+    std::cout << "Deterministic physics tests passed!" << std::endl;
+    return 0;
+}
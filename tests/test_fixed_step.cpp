@@ -0,0 +1,139 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cassert>
+#include <cmath>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+
+static void build_scene(World &world, std::vector<ObstacleObject *> &walls)
+{
+    auto wall = [&](float x, float y, float w, float h)
+    {
+        walls.push_back(new ObstacleObject(world));
+        walls.back()->set_rect(Rect(x, y, w, h));
+    };
+    wall(0, 590, 800, 10);
+    wall(0, 0, 10, 600);
+    wall(790, 0, 10, 600);
+
+    for (int i = 0; i < 40; ++i)
+    {
+        auto *p = world.physics().create_physical_object();
+        p->set_rect(Rect(20 + i * 19, 100 + (i % 7) * 20, 10, 10));
+        p->set_speed(Vec2((i % 5) * 40.0f - 80, 0));
+        p->set_force(Vec2(0, 1000));
+    }
+}
+
+static std::vector<Rect> snapshot(World &world)
+{
+    std::vector<Rect> rects;
+    for (auto *p : world.physics().objects())
+        rects.push_back(p->get_rect());
+    return rects;
+}
+
+static void destroy_scene(World &world, std::vector<ObstacleObject *> &walls)
+{
+    world.physics().clear();
+    for (auto wall : walls)
+        delete wall;
+    walls.clear();
+}
+
+int main()
+{
+    std::vector<ObstacleObject *> walls;
+
+    // ---------- 帧率抖动不影响结果: 与直接按 tick 步进完全一致 ----------
+    std::vector<Rect> jittered;
+    int total_steps = 0;
+    {
+        World world;
+        build_scene(world, walls);
+
+        auto &physics = world.physics();
+        physics.set_fixed_step(true);
+        physics.set_tick_rate(60);
+
+        std::mt19937 rng(3);
+        std::uniform_real_distribution<float> frame_dist(1.0f / 240, 1.0f / 20);
+        for (int frame = 0; frame < 200; ++frame)
+        {
+            physics.on_frame(frame_dist(rng));
+            total_steps += physics.get_frame_steps();
+            assert(physics.get_dropped_time() == 0);
+            assert(physics.get_interpolation_alpha() >= 0 && physics.get_interpolation_alpha() < 1);
+        }
+
+        jittered = snapshot(world);
+        destroy_scene(world, walls);
+    }
+    {
+        World world;
+        build_scene(world, walls);
+        for (int step = 0; step < total_steps; ++step)
+            world.physics().on_update(1.0f / 60);
+
+        assert(snapshot(world) == jittered);
+        destroy_scene(world, walls);
+    }
+    std::cout << "Jittered frames: " << total_steps << " fixed steps, same result as stepping directly\n";
+
+    // ---------- 长帧被限制在 max_steps_per_frame 步 ----------
+    {
+        World world;
+        build_scene(world, walls);
+
+        auto &physics = world.physics();
+        physics.set_fixed_step(true);
+        physics.set_tick_rate(60);
+        physics.set_max_steps_per_frame(4);
+
+        physics.on_frame(1.0f);
+        assert(physics.get_frame_steps() == 4);
+        assert(std::abs(physics.get_dropped_time() - (1.0f - 4.0f / 60)) < 1.0f / 60);
+        assert(physics.get_interpolation_alpha() < 1);
+        std::cout << "1s hitch: " << physics.get_frame_steps() << " steps, dropped " << physics.get_dropped_time() << " s\n";
+
+        destroy_scene(world, walls);
+    }
+
+    // ---------- 渲染插值: 在上一步与当前状态之间线性混合 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_fixed_step(true);
+        physics.set_tick_rate(50);
+
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(100, 100, 10, 10));
+        p->set_speed(Vec2(500, 0));
+
+        physics.on_frame(0.01f);
+        assert(physics.get_frame_steps() == 0);
+        assert(physics.interpolated_rect(*p) == p->get_rect());
+
+        physics.on_frame(0.02f);
+        assert(physics.get_frame_steps() == 1);
+        assert(std::abs(physics.get_interpolation_alpha() - 0.5f) < 1e-4f);
+
+        Rect blended = physics.interpolated_rect(*p);
+        assert(std::abs(blended.get_x() - 105) < 1e-3f);
+        assert(std::abs(p->get_rect().get_x() - 110) < 1e-3f);
+        std::cout << "Interpolated x at alpha 0.5: " << blended.get_x() << "\n";
+
+        // set_rect 视为瞬移, 插值不会从旧位置滑过来
+        p->set_rect(Rect(300, 100, 10, 10));
+        assert(physics.interpolated_rect(*p) == p->get_rect());
+
+        physics.clear();
+    }
+
+    std::cout << "Fixed step tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,144 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <algorithm>
+#include <cassert>
+
+#include <echo_strike/collision/collision_manager.hpp>
+
+// 旧做法: 为一次查询临时创建碰撞盒, 每一步都会改动四叉树。
+static std::vector<CollisionBox *> temporary_box_query(CollisionManager &manager, const Circle &area)
+{
+    auto box = manager.create_collision_box();
+    box->set_circle(area);
+    box->set_src(CollisionLayer::Player);
+    box->add_dst(CollisionLayer::Enemy);
+    auto result = box->process_collide();
+    manager.destroy_collision_box(box);
+
+    std::erase_if(
+        result,
+        [](CollisionBox *other)
+        { return other->get_src() != CollisionLayer::Enemy; });
+    return result;
+}
+
+static bool same_set(std::vector<CollisionBox *> a, std::vector<CollisionBox *> b)
+{
+    std::sort(a.begin(), a.end());
+    std::sort(b.begin(), b.end());
+    return a == b;
+}
+
+int main()
+{
+    auto &manager = CollisionManager::instance();
+    std::vector<CollisionBox *> out;
+
+    auto &enemy = *manager.create_collision_box();
+    enemy.set_rect(Rect{100, 100, 20, 20});
+    enemy.set_src(CollisionLayer::Enemy);
+
+    auto &round_enemy = *manager.create_collision_box();
+    round_enemy.set_circle(Circle(200, 110, 10));
+    round_enemy.set_src(CollisionLayer::Enemy);
+
+    auto &wall = *manager.create_collision_box(true);
+    wall.set_rect(Rect{0, 300, 400, 20});
+    wall.set_src(CollisionLayer::Obstacle);
+
+    // ---------- 层掩码筛选 ----------
+    manager.overlap_rect(Rect{0, 0, 400, 400}, layer_mask(CollisionLayer::Enemy), out);
+    assert(same_set(out, {&enemy, &round_enemy}));
+
+    out.clear();
+    manager.overlap_rect(Rect{0, 0, 400, 400}, layer_mask(CollisionLayer::Enemy, CollisionLayer::Obstacle), out);
+    assert(out.size() == 3);
+
+    // ---------- 点查询按实际形状判断: 圆形包围盒的角落不算命中 ----------
+    out.clear();
+    manager.overlap_point(Vec2(110, 110), ALL_COLLISION_LAYERS, out);
+    assert(same_set(out, {&enemy}));
+
+    out.clear();
+    manager.overlap_point(Vec2(191, 101), ALL_COLLISION_LAYERS, out);
+    assert(out.empty());
+
+    // ---------- 圆形查询: 爆炸半径 ----------
+    out.clear();
+    manager.overlap_circle(Circle(150, 110, 31), layer_mask(CollisionLayer::Enemy), out);
+    assert(same_set(out, {&enemy}));
+
+    out.clear();
+    manager.overlap_circle(Circle(150, 110, 41), layer_mask(CollisionLayer::Enemy), out);
+    assert(same_set(out, {&enemy, &round_enemy}));
+
+    // ---------- 尚未 flush 的移动按当前位置计入, 查询不会触发 flush ----------
+    enemy.set_rect(Rect{500, 500, 20, 20});
+    assert(enemy.is_dirty());
+
+    out.clear();
+    manager.overlap_rect(Rect{490, 490, 40, 40}, ALL_COLLISION_LAYERS, out);
+    assert(same_set(out, {&enemy}));
+
+    out.clear();
+    manager.overlap_rect(Rect{90, 90, 40, 40}, ALL_COLLISION_LAYERS, out);
+    assert(out.empty());
+    assert(enemy.is_dirty());
+
+    // 结果是追加的, 不会清掉调用者缓冲区里已有的内容
+    out.assign(1, &wall);
+    manager.overlap_point(Vec2(510, 510), ALL_COLLISION_LAYERS, out);
+    assert(out.size() == 2 && out[0] == &wall && out[1] == &enemy);
+
+    manager.clear();
+
+    // ---------- 大规模随机场景: 与临时碰撞盒的结果一致 ----------
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> pos_dist(0.0f, 780.0f);
+    for (int i = 0; i < 2000; ++i)
+    {
+        auto box = manager.create_collision_box();
+        box->set_rect(Rect{pos_dist(rng), pos_dist(rng) * 0.75f, 12, 12});
+        box->set_src(i % 3 ? CollisionLayer::Enemy : CollisionLayer::Player);
+    }
+    manager.flush();
+
+    std::vector<Circle> blasts;
+    for (int i = 0; i < 1000; ++i)
+        blasts.emplace_back(pos_dist(rng), pos_dist(rng) * 0.75f, 40.0f);
+
+    using Clock = std::chrono::high_resolution_clock;
+
+    size_t temporary_hits = 0, overlap_hits = 0;
+    auto start = Clock::now();
+    for (auto &blast : blasts)
+        temporary_hits += temporary_box_query(manager, blast).size();
+    auto temporary_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    for (auto &blast : blasts)
+    {
+        out.clear();
+        manager.overlap_circle(blast, layer_mask(CollisionLayer::Enemy), out);
+        overlap_hits += out.size();
+    }
+    auto overlap_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    for (int i = 0; i < 50; ++i)
+    {
+        out.clear();
+        manager.overlap_circle(blasts[i], layer_mask(CollisionLayer::Enemy), out);
+        assert(same_set(out, temporary_box_query(manager, blasts[i])));
+    }
+    assert(temporary_hits == overlap_hits);
+
+    std::cout << "1000 blast queries over 2000 boxes (" << overlap_hits << " hits):\n";
+    std::cout << "  temporary box: " << temporary_ms << " ms\n";
+    std::cout << "  overlap_circle: " << overlap_ms << " ms\n";
+
+    manager.clear();
+    std::cout << "Overlap query tests passed!" << std::endl;
+    return 0;
+}
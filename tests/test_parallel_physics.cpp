@@ -0,0 +1,62 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+
+#include "physics_arena.hpp"
+
+struct BodyState
+{
+    Rect rect;
+    Vec2 speed;
+
+    bool operator==(const BodyState &other) const { return rect == other.rect && speed == other.speed; }
+};
+
+// 四面墙围起的场地中, 受重力的物体以随机速度运动, 返回每帧的平均耗时 (毫秒)。
+static double simulate(size_t worker_count, int body_count, int frames, std::vector<BodyState> &result)
+{
+    Arena arena(4000);
+    auto &physics = arena.physics();
+    physics.set_worker_count(worker_count);
+    assert(physics.get_worker_count() == std::max<size_t>(worker_count, 1));
+    arena.enclose();
+    arena.scatter(body_count, 8, 300, Vec2(0, 500), 11);
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+    arena.run(frames);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    result.clear();
+    for (auto *p : physics.objects())
+        result.push_back({p->get_rect(), p->get_speed()});
+    return ms / frames;
+}
+
+int main()
+{
+    const int body_count = 4000;
+    const int frames = 30;
+
+    std::vector<BodyState> serial, parallel;
+    double serial_ms = simulate(1, body_count, frames, serial);
+
+    // ---------- 不同线程数 (包括不能整除的分块) 的结果与串行逐位一致 ----------
+    for (size_t workers : {2, 3, 4, 7})
+    {
+        double parallel_ms = simulate(workers, body_count, frames, parallel);
+        assert(parallel == serial);
+        std::cout << "  " << workers << " workers: " << parallel_ms << " ms/frame\n";
+    }
+    std::cout << "  serial:    " << serial_ms << " ms/frame (" << body_count << " bodies)\n";
+
+    // ---------- 物体数低于阈值时走串行路径, 结果同样一致 ----------
+    simulate(1, 100, frames, serial);
+    simulate(4, 100, frames, parallel);
+    assert(parallel == serial);
+
+    std::cout << "Parallel physics tests passed!" << std::endl;
+    return 0;
+}
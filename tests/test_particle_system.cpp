@@ -0,0 +1,211 @@
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/collision/tile_collision_map.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+#include <echo_strike/physics/particle_system.hpp>
+
+// 100k 个粒子在 4000x4000 的场地中下落, 返回每步的平均耗时 (毫秒)。
+static double rain(ParticleCollision collision)
+{
+    World world(Rect(0, 0, 4000, 4000));
+    auto &tiles = world.collision().create_tile_map(Point(0, 0), 20, 200, 200);
+    tiles.fill(0, 199, 200, 1, TileType::Solid);
+
+    std::vector<std::unique_ptr<ObstacleObject>> blocks;
+    for (int i = 0; i < 100; ++i)
+    {
+        blocks.push_back(std::make_unique<ObstacleObject>(world));
+        blocks.back()->set_rect(Rect(i * 40.0f, 2000 + (i % 7) * 100.0f, 30, 20));
+    }
+
+    ParticleSystem particles(world, 100000);
+    particles.seed(1);
+    particles.set_gravity(Vec2(0, 500));
+    particles.set_collision(collision);
+
+    ParticleEmitter emitter;
+    emitter.area = Rect(0, 0, 4000, 3000);
+    emitter.velocity_spread = Vec2(100, 100);
+    emitter.min_life = 100, emitter.max_life = 100;
+    particles.emit(emitter, 100000);
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+    for (int frame = 0; frame < 100; ++frame)
+        particles.on_update(1.0f / 60);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / 100;
+
+    assert(particles.size() == 100000);
+    if (collision != ParticleCollision::None)
+        for (size_t i = 0; i < particles.size(); ++i)
+            assert(particles.position(i).get_y() < 3980);
+    return ms;
+}
+
+int main()
+{
+    // ---------- 发射器按速率生成, 寿命结束后删除 ----------
+    {
+        World world;
+        ParticleSystem particles(world);
+        particles.seed(7);
+
+        auto *emitter = particles.create_emitter();
+        emitter->area = Rect(100, 100, 10, 10);
+        emitter->rate = 600;
+        emitter->min_life = emitter->max_life = 0.5f;
+        emitter->color = Color(255, 128, 0, 200);
+
+        particles.on_update(1.0f / 60);
+        assert(particles.size() == 10);
+        Color color = particles.color(0);
+        assert(color.R == 255 && color.G == 128 && color.B == 0 && color.A == 200);
+
+        for (int frame = 0; frame < 119; ++frame)
+            particles.on_update(1.0f / 60);
+        // 稳定后约为 rate * life
+        assert(particles.size() >= 290 && particles.size() <= 310);
+
+        emitter->enable = false;
+        for (int frame = 0; frame < 31; ++frame)
+            particles.on_update(1.0f / 60);
+        assert(particles.size() == 0);
+
+        // 低发射率的余数会累积下来
+        emitter->enable = true;
+        emitter->rate = 20;
+        for (int frame = 0; frame < 15; ++frame)
+            particles.on_update(1.0f / 60);
+        assert(particles.size() == 4 || particles.size() == 5);
+
+        particles.destroy_emitter(emitter);
+        assert(particles.emitters().empty());
+    }
+
+    // ---------- 积分: 向量化的部分与标量尾部结果一致; 达到容量后丢弃 ----------
+    {
+        World world;
+        ParticleSystem particles(world, 11);
+        particles.set_gravity(Vec2(0, 600));
+        particles.set_drag(0.5f);
+
+        ParticleEmitter emitter;
+        emitter.area = Rect(0, 0, 0, 0);
+        emitter.velocity = Vec2(120, -300);
+        emitter.min_life = emitter.max_life = 10;
+        particles.emit(emitter, 20);
+        assert(particles.size() == 11);
+
+        for (int frame = 0; frame < 30; ++frame)
+            particles.on_update(1.0f / 60);
+        for (size_t i = 1; i < particles.size(); ++i)
+        {
+            assert(particles.position(i) == particles.position(0));
+            assert(particles.velocity(i) == particles.velocity(0));
+        }
+
+        float vx = 120, vy = -300, x = 0, y = 0, dt = 1.0f / 60, damping = 1 - 0.5f * dt;
+        for (int frame = 0; frame < 30; ++frame)
+        {
+            vx = vx * damping, vy = vy * damping + 600 * dt;
+            x += vx * dt, y += vy * dt;
+        }
+        assert(std::abs(particles.position(0).get_x() - x) < 1e-2f);
+        assert(std::abs(particles.position(0).get_y() - y) < 1e-2f);
+
+        particles.set_capacity(4);
+        assert(particles.size() == 4);
+        particles.clear();
+        assert(particles.size() == 0);
+    }
+
+    // ---------- 网格碰撞: 落到地面上弹起, 不穿过; 单向平台从下方可以穿过 ----------
+    {
+        World world;
+        auto &tiles = world.collision().create_tile_map(Point(0, 0), 10, 80, 60);
+        tiles.fill(0, 59, 80, 1, TileType::Solid);
+        tiles.fill(40, 30, 20, 1, TileType::OneWay);
+
+        ParticleSystem particles(world);
+        particles.set_gravity(Vec2(0, 1000));
+        particles.set_collision(ParticleCollision::Tiles);
+        particles.set_restitution(0.5f);
+
+        ParticleEmitter emitter;
+        emitter.min_life = emitter.max_life = 5;
+        emitter.area = Rect(100, 100, 100, 100);
+        particles.emit(emitter, 50);
+        emitter.area = Rect(450, 500, 100, 50);
+        emitter.velocity = Vec2(0, -900);
+        particles.emit(emitter, 50);
+
+        bool bounced = false;
+        for (int frame = 0; frame < 180; ++frame)
+        {
+            particles.on_update(1.0f / 60);
+            for (size_t i = 0; i < particles.size(); ++i)
+            {
+                assert(particles.position(i).get_y() < 590);
+                bounced |= i < 50 && particles.velocity(i).get_y() < -100;
+            }
+        }
+        assert(bounced);
+
+        // 向上穿过单向平台, 落回时停在平台上
+        for (size_t i = 50; i < particles.size(); ++i)
+            assert(particles.position(i).get_y() < 300);
+    }
+
+    // ---------- 静态索引碰撞: 被障碍物挡住, 粒子不占用碰撞盒, 也不进入物理步进 ----------
+    {
+        World world;
+        ObstacleObject floor(world), other(world);
+        floor.set_rect(Rect(0, 500, 800, 20));
+        other.set_rect(Rect(0, 300, 800, 20));
+        other.collision_box().set_src(CollisionLayer::Enemy); // 不在默认的 collision_mask 中
+        size_t box_count = world.collision().size();
+
+        ParticleSystem particles(world);
+        particles.set_gravity(Vec2(0, 1000));
+        particles.set_collision(ParticleCollision::Static);
+        particles.set_restitution(0);
+
+        ParticleEmitter emitter;
+        emitter.area = Rect(0, 0, 800, 200);
+        emitter.min_life = emitter.max_life = 5;
+        particles.emit(emitter, 1000);
+
+        for (int frame = 0; frame < 120; ++frame)
+            particles.on_update(1.0f / 60);
+        for (size_t i = 0; i < particles.size(); ++i)
+        {
+            assert(particles.position(i).get_y() > 320 && particles.position(i).get_y() <= 500);
+            assert(std::abs(particles.velocity(i).get_y()) < 20);
+        }
+
+        assert(world.collision().size() == box_count && world.physics().size() == 0);
+        particles.render(nullptr);
+    }
+
+    // ---------- 性能: 单线程 10 万个粒子 ----------
+    {
+        double none_ms = rain(ParticleCollision::None);
+        double tiles_ms = rain(ParticleCollision::Tiles);
+        double static_ms = rain(ParticleCollision::Static);
+        std::cout << "100000 particles:\n";
+        std::cout << "  no collision:     " << none_ms << " ms/step\n";
+        std::cout << "  tile collision:   " << tiles_ms << " ms/step\n";
+        std::cout << "  static collision: " << static_ms << " ms/step\n";
+    }
+
+    std::cout << "Particle system tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,120 @@
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cassert>
+
+#include "physics_arena.hpp"
+
+// 计数部分, 不含耗时。
+static std::vector<size_t> counts(const PhysicsStats &stats)
+{
+    return {stats.awake_bodies, stats.predictions, stats.broadphase_candidates, stats.narrowphase_tests,
+            stats.impacts, stats.stale_events, stats.impact_limit_hits, stats.contacts,
+            static_cast<size_t>(stats.velocity_iterations), static_cast<size_t>(stats.position_iterations),
+            stats.tile_corrections};
+}
+
+// 四面墙围起的场地中随机运动的一群物体, 返回每步的计数。
+static std::vector<std::vector<size_t>> swarm(size_t worker_count)
+{
+    Arena arena(2000);
+    arena.physics().set_worker_count(worker_count);
+    arena.enclose();
+    arena.scatter(600, 10, 400, Vec2(0, 600), 2);
+
+    std::vector<std::vector<size_t>> result;
+    for (int frame = 0; frame < 120; ++frame)
+    {
+        arena.run(1);
+        result.push_back(counts(arena.physics().get_stats()));
+    }
+    return result;
+}
+
+int main()
+{
+    // ---------- 落地: 一次碰撞, 预测与候选都被计入 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(100, 570, 10, 10));
+        p->set_speed(Vec2(0, 1200));
+        p->set_restitution(0);
+
+        physics.on_update(1.0f / 60);
+        const auto &stats = physics.get_stats();
+        assert(stats.awake_bodies == 1);
+        assert(stats.impacts == 1 && stats.impacts == physics.get_impact_count());
+        assert(stats.predictions >= 2); // 帧初一次, 碰撞后重新预测一次
+        assert(stats.broadphase_candidates >= stats.narrowphase_tests && stats.narrowphase_tests >= 1);
+        assert(stats.impact_limit_hits == 0);
+
+        // 耗时: 各阶段之和不超过总耗时
+        double phases = stats.wake_ms + stats.forces_ms + stats.contacts_ms + stats.ccd_ms +
+                        stats.advance_ms + stats.positions_ms + stats.sleep_ms;
+        assert(stats.total_ms >= 0 && phases <= stats.total_ms + 1e-6);
+
+        // ---------- 静止接触交给求解器; 休眠后不再有任何工作 ----------
+        for (int frame = 0; frame < 10; ++frame)
+            physics.on_update(1.0f / 60);
+        assert(physics.get_stats().contacts == 1);
+        assert(physics.get_stats().impacts == 0);
+        assert(physics.get_stats().position_iterations <= physics.get_position_iterations());
+
+        for (int frame = 0; frame < 120; ++frame)
+            physics.on_update(1.0f / 60);
+        assert(physics.get_stats().awake_bodies == 0);
+        assert(physics.get_stats().predictions == 0 && physics.get_stats().contacts == 0);
+    }
+
+    // ---------- 夹在两堵墙之间高速来回弹的物体达到单步碰撞上限 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        ObstacleObject left(world), right(world);
+        left.set_rect(Rect(90, 0, 10, 600));
+        right.set_rect(Rect(112, 0, 10, 600));
+
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(101, 300, 10, 10));
+        p->set_speed(Vec2(20000, 0));
+        p->set_restitution(1);
+
+        physics.on_update(1.0f / 60);
+        assert(physics.get_stats().impact_limit_hits == 1);
+    }
+
+    // ---------- 计数与线程数无关 ----------
+    assert(swarm(1) == swarm(4));
+
+    // ---------- 开启后每步输出一行 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.create_physical_object()->set_speed(Vec2(10, 0));
+        physics.set_log_stats(true);
+
+        std::ostringstream log;
+        auto old = std::clog.rdbuf(log.rdbuf());
+        physics.on_update(1.0f / 60);
+        physics.on_update(1.0f / 60);
+        std::clog.rdbuf(old);
+
+        std::string text = log.str();
+        assert(text.find("physics: ") == 0);
+        assert(std::count(text.begin(), text.end(), '\n') == 2);
+        std::cout << text;
+        physics.clear();
+    }
+
+    std::cout << "Physics stats tests passed!" << std::endl;
+    return 0;
+}
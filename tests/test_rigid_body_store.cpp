@@ -0,0 +1,224 @@
+#include <iostream>
+#include <vector>
+#include <random>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+#include <algorithm>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/rigid_body_store.hpp>
+
+static void fill(RigidBodyStore &store, size_t count, unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> pos_dist(0, 800), speed_dist(-300, 300), mass_dist(0.5f, 4.0f);
+    for (size_t i = 0; i < count; ++i)
+    {
+        size_t index = store.create(nullptr);
+        store.set_rect(index, Rect(pos_dist(rng), pos_dist(rng) * 0.75f, 10, 10));
+        store.set_speed(index, Vec2(speed_dist(rng), speed_dist(rng)));
+        store.set_force(index, Vec2(0, 1000));
+        store.set_mass(index, mass_dist(rng));
+        if (i % 3 == 0)
+            store.set_boundary(index, Rect(0, 0, 800, 600));
+    }
+}
+
+int main()
+{
+    // ---------- 批量推进与逐个推进结果逐位一致 (SIMD 部分与标量尾部) ----------
+    {
+        RigidBodyStore batch, single;
+        fill(batch, 1003, 1);
+        fill(single, 1003, 1);
+
+        for (int step = 1; step <= 60; ++step)
+        {
+            batch.apply_forces(0, batch.size(), 1.0f / 60);
+            batch.advance_all(step / 60.0f);
+            for (size_t i = 0; i < single.size(); ++i)
+            {
+                single.apply_forces(i, i + 1, 1.0f / 60);
+                single.advance(i, step / 60.0f);
+            }
+        }
+
+        for (size_t i = 0; i < batch.size(); ++i)
+        {
+            assert(batch.rect(i) == single.rect(i));
+            assert(batch.speed(i) == single.speed(i));
+        }
+    }
+
+    // ---------- 半隐式欧拉积分与边界限制: 先按力更新速度, 再按新速度移动 ----------
+    {
+        RigidBodyStore store;
+        size_t index = store.create(nullptr);
+
+        const float dt = 1.0f / 60;
+        float x = 750, y = 20, vx = 120, vy = -50;
+
+        store.set_rect(index, Rect(x, y, 10, 10));
+        store.set_speed(index, Vec2(vx, vy));
+        store.set_force(index, Vec2(0, 300));
+        store.set_mass(index, 2);
+        store.set_boundary(index, Rect(0, 0, 800, 600));
+
+        for (int step = 1; step <= 30; ++step)
+        {
+            store.apply_forces(index, index + 1, dt);
+            store.advance(index, step * dt);
+
+            vy += 300 / 2.0f * dt;
+            x = std::min(x + vx * dt, 790.0f);
+            y += vy * dt;
+        }
+
+        Rect actual = store.rect(index);
+        assert(std::abs(actual.get_x() - x) < 1e-3f);
+        assert(std::abs(actual.get_y() - y) < 1e-3f);
+        assert(actual.right() <= 800 && actual.bottom() >= 0);
+        assert(store.speed(index).get_x() == 0);
+        assert(std::abs(store.speed(index).get_y() - vy) < 1e-3f);
+    }
+
+    // ---------- 删除物体后其他句柄仍然指向自己的数据 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        std::vector<PhysicalObject *> objects;
+        for (int i = 0; i < 10; ++i)
+        {
+            objects.push_back(physics.create_physical_object());
+            objects.back()->set_rect(Rect(i * 50.0f, 0, 10, 10));
+            objects.back()->set_speed(Vec2(0, i));
+        }
+
+        physics.destroy_physical_object(objects[2]);
+        physics.destroy_physical_object(objects[0]);
+        assert(physics.bodies().size() == 8);
+
+        for (int i = 1; i < 10; ++i)
+        {
+            if (i == 2)
+                continue;
+            assert(objects[i]->get_rect().get_x() == i * 50.0f);
+            assert(objects[i]->get_speed().get_y() == i);
+        }
+        for (size_t i = 0; i < physics.bodies().size(); ++i)
+            assert(physics.bodies().owner(i)->get_rect() == physics.bodies().rect(i));
+
+        physics.clear();
+        assert(physics.bodies().size() == 0);
+    }
+
+    // ---------- 通过 Object 指针读写的也是存储中的状态 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        auto *obj = physics.create_physical_object();
+        obj->set_rect(Rect(0, 0, 10, 10));
+        obj->set_speed(Vec2(60, 0));
+
+        physics.on_update(0.5f);
+        Object *base = obj->collision_box().get_object();
+        assert(base == obj);
+        assert(base->get_rect() == obj->get_rect() && base->get_rect().get_x() == 30);
+        assert(base->get_speed() == Vec2(60, 0));
+
+        base->set_speed(Vec2(0, 20));
+        base->set_force(Vec2(0, 10));
+        base->set_rect(Rect(100, 0, 10, 10));
+        assert(physics.bodies().speed(0) == Vec2(0, 20));
+        assert(obj->get_force() == Vec2(0, 10) && obj->get_rect().get_x() == 100);
+        physics.clear();
+    }
+
+    // ---------- 直接构造的物体同样登记到 PhysicsManager, 存储与 objects() 始终一一对应 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        auto in_step = [&]
+        {
+            assert(physics.bodies().size() == physics.size());
+            for (size_t j = 0; j < physics.size(); ++j)
+                assert(physics.bodies().owner(j) == physics.objects()[j]);
+        };
+
+        PhysicalObject stray(world);
+        stray.set_speed(Vec2(10, 0));
+        std::vector<PhysicalObject *> objects;
+        for (int i = 0; i < 20; ++i)
+        {
+            objects.push_back(physics.create_physical_object());
+            if (i % 3 == 2)
+            {
+                physics.destroy_physical_object(objects[i / 2]);
+                objects.erase(objects.begin() + i / 2);
+            }
+            in_step();
+        }
+        {
+            PhysicalObject scoped(world);
+            in_step();
+        }
+        in_step();
+
+        physics.on_update(1);
+        assert(stray.get_rect().get_x() == 10);
+
+        // clear 只删除管理器创建的物体
+        physics.clear();
+        assert(physics.size() == 1 && physics.objects()[0] == &stray);
+        in_step();
+    }
+
+    // ---------- 性能: 5 万个物体的积分, SoA 批量推进对比逐个调用 Object::on_update ----------
+    {
+        const size_t count = 50000;
+        const int steps = 100;
+        using Clock = std::chrono::high_resolution_clock;
+
+        RigidBodyStore store;
+        fill(store, count, 2);
+
+        std::vector<Object> objects(count);
+        for (size_t i = 0; i < count; ++i)
+        {
+            objects[i].set_rect(store.rect(i));
+            objects[i].set_speed(store.speed(i));
+            objects[i].set_force(store.force(i));
+            objects[i].set_mass(1 / store.inv_mass(i));
+            if (i % 3 == 0)
+            {
+                objects[i].set_boundary(Rect(0, 0, 800, 600));
+                objects[i].set_motion_type(Object::MotionType::LimitedInBoundary);
+            }
+        }
+
+        auto start = Clock::now();
+        for (int step = 1; step <= steps; ++step)
+            for (auto &object : objects)
+                object.on_update(1000.0f / 60);
+        auto object_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        start = Clock::now();
+        for (int step = 1; step <= steps; ++step)
+        {
+            store.apply_forces(0, store.size(), 1.0f / 60);
+            store.advance_all(step / 60.0f);
+        }
+        auto store_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+        std::cout << count << " bodies x " << steps << " steps:\n";
+        std::cout << "  Object::on_update:          " << object_ms << " ms\n";
+        std::cout << "  RigidBodyStore::advance_all: " << store_ms << " ms\n";
+    }
+
+    std::cout << "Rigid body store tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,135 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cassert>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+
+static void run(PhysicsManager &physics, int frames)
+{
+    for (int frame = 0; frame < frames; ++frame)
+        physics.on_update(1.0f / 60);
+}
+
+static PhysicalObject *drop(PhysicsManager &physics, float x, float y)
+{
+    auto *p = physics.create_physical_object();
+    p->set_rect(Rect(x, y, 10, 10));
+    p->set_force(Vec2(0, 1000));
+    return p;
+}
+
+// 地面上一层互不接触的物体, 返回物体全部静止后每帧的平均耗时 (毫秒)。
+static double resting_layer(bool sleep_enabled, int body_count)
+{
+    World world(Rect(0, 0, 8000, 1000));
+    auto &physics = world.physics();
+    physics.set_sleep_enabled(sleep_enabled);
+
+    ObstacleObject floor(world);
+    floor.set_rect(Rect(0, 590, 8000, 10));
+    for (int i = 0; i < body_count; ++i)
+        drop(physics, 10 + i * 15.0f, 500 + (i % 5) * 10.0f);
+
+    run(physics, 600);
+    assert(physics.get_awake_count() == (sleep_enabled ? 0 : physics.size()));
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+    run(physics, 120);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+
+    physics.clear();
+    return ms / 120;
+}
+
+int main()
+{
+    // ---------- 落地静止后休眠, 休眠的物体不再移动 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        auto *floor = new ObstacleObject(world);
+        floor->set_rect(Rect(0, 590, 800, 10));
+
+        std::vector<PhysicalObject *> bodies;
+        for (int i = 0; i < 40; ++i)
+            bodies.push_back(drop(physics, 20 + i * 18.0f, 100 + (i % 5) * 30.0f));
+
+        run(physics, 600);
+        assert(physics.get_awake_count() == 0);
+
+        std::vector<Rect> rects;
+        for (auto *p : bodies)
+        {
+            assert(p->is_sleeping());
+            assert(p->get_speed() == Vec2());
+            assert(p->get_rect().top() <= 590 && p->get_rect().top() > 589);
+            rects.push_back(p->get_rect());
+        }
+
+        run(physics, 60);
+        for (size_t i = 0; i < bodies.size(); ++i)
+            assert(bodies[i]->get_rect() == rects[i]);
+
+        // ---------- 删除地面后, 原来压在上面的物体被唤醒并下落 ----------
+        delete floor;
+        assert(physics.get_awake_count() == bodies.size());
+        run(physics, 10);
+        for (auto *p : bodies)
+            assert(p->get_rect().top() > 590);
+    }
+
+    // ---------- 相互接触的一排物体构成一个岛, 一起休眠、一起唤醒 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+
+        std::vector<PhysicalObject *> row;
+        for (int i = 0; i < 10; ++i)
+            row.push_back(drop(physics, 100 + i * 10.0f, 580));
+
+        run(physics, 120);
+        assert(physics.get_awake_count() == 0);
+
+        // 让一端跳起, 整排被唤醒
+        row.front()->set_speed(Vec2(0, -150));
+        assert(physics.get_awake_count() == row.size());
+        for (auto *p : row)
+            assert(!p->is_sleeping());
+
+        run(physics, 300);
+        assert(physics.get_awake_count() == 0);
+
+        // ---------- 落下的物体撞到休眠的物体时将其唤醒 ----------
+        Rect before = row[5]->get_rect();
+        auto *falling = drop(physics, before.get_x(), 300);
+        falling->set_speed(Vec2(0, 400));
+        run(physics, 30);
+        assert(!row[5]->is_sleeping());
+        assert(falling->get_rect().top() <= before.bottom() + 1);
+
+        run(physics, 600);
+        assert(physics.get_awake_count() == 0);
+    }
+
+    // ---------- 性能: 静止的物体休眠后不再参与每帧的预测与推进 ----------
+    {
+        const int body_count = 500;
+        double awake_ms = resting_layer(false, body_count);
+        double sleep_ms = resting_layer(true, body_count);
+        std::cout << body_count << " resting bodies:\n";
+        std::cout << "  sleep disabled: " << awake_ms << " ms/frame\n";
+        std::cout << "  sleep enabled:  " << sleep_ms << " ms/frame\n";
+    }
+
+    std::cout << "Sleep tests passed!" << std::endl;
+    return 0;
+}
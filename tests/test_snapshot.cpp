@@ -0,0 +1,151 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <chrono>
+#include <cassert>
+
+#include <echo_strike/collision/collision_manager.hpp>
+
+#include "physics_arena.hpp"
+
+// 四面墙围起的场地中随机运动、最终落地堆积的物体。
+struct Scene : Arena
+{
+    explicit Scene(int body_count) : Arena(1000)
+    {
+        physics().set_deterministic(true);
+        enclose();
+        scatter(body_count, 10, 300, Vec2(0, 800), 7);
+    }
+
+    // 运行 ticks 步, 返回每步结束时的状态哈希。
+    std::vector<uint64_t> record(int ticks)
+    {
+        std::vector<uint64_t> hashes;
+        for (int i = 0; i < ticks; ++i)
+        {
+            physics().on_update(1.0f / 60);
+            hashes.push_back(physics().get_state_hash());
+        }
+        return hashes;
+    }
+};
+
+int main()
+{
+    // ---------- 恢复后重新模拟, 每个 tick 的结果与第一次逐位相同 (包括休眠与热启动) ----------
+    {
+        Scene scene(300);
+        auto &physics = scene.physics();
+        scene.run(120);
+
+        auto saved = physics.snapshot();
+        assert(saved.size() == 300);
+        uint64_t saved_hash = physics.get_state_hash();
+        auto first = scene.record(240);
+        assert(physics.get_awake_count() < physics.size()); // 模拟过程中有物体休眠, 排列顺序已改变
+
+        assert(physics.restore(saved));
+        assert(physics.get_step_count() == 120);
+        assert(physics.compute_state_hash() == saved_hash);
+        assert(scene.record(240) == first);
+
+        // ---------- 改变输入后分歧, 再次回滚仍能得到原来的结果 ----------
+        assert(physics.restore(saved));
+        scene.bodies[3]->set_speed(Vec2(0, -500));
+        auto changed = scene.record(240);
+        assert(changed != first);
+
+        assert(physics.restore(saved));
+        assert(scene.record(240) == first);
+
+        // ---------- 碰撞索引同步到恢复后的位置 ----------
+        assert(physics.restore(saved));
+        std::vector<CollisionBox *> found;
+        for (auto *p : scene.bodies)
+        {
+            found.clear();
+            scene.world.collision().overlap_rect(p->get_rect(), ALL_COLLISION_LAYERS, found);
+            assert(std::find(found.begin(), found.end(), &p->collision_box()) != found.end());
+        }
+
+        // ---------- 保存后物体增减时拒绝恢复 ----------
+        auto *extra = physics.create_physical_object();
+        physics.destroy_physical_object(scene.bodies.back());
+        scene.bodies.back() = extra;
+        assert(!physics.restore(saved));
+        physics.destroy_physical_object(extra);
+        scene.bodies.pop_back();
+        assert(!physics.restore(saved));
+    }
+
+    // ---------- 碰撞盒的开关、形状和层随快照恢复; 休眠物体的碰撞盒回到保存时的位置 ----------
+    {
+        Scene scene(100);
+        auto &physics = scene.physics();
+        scene.run(540);
+        assert(physics.get_awake_count() < physics.size());
+        auto *sleeper = physics.objects().back();
+        auto *body = physics.objects().front();
+        Rect sleeper_rect = sleeper->get_rect();
+        auto &box = body->collision_box();
+        auto dst = box.get_dst();
+        auto src = box.get_src();
+
+        auto saved = physics.snapshot();
+        auto first = scene.record(60);
+
+        assert(physics.restore(saved));
+        box.set_enable(false);
+        box.set_shape(ShapeType::Circle);
+        box.set_src(CollisionLayer::Enemy);
+        box.add_dst(CollisionLayer::Player);
+        sleeper->set_rect(sleeper_rect + Vec2(0, -200));
+        scene.run(30);
+
+        assert(physics.restore(saved));
+        assert(box.get_enable() && box.get_shape() == ShapeType::Rect);
+        assert(box.get_src() == src && box.get_dst() == dst);
+        assert(sleeper->is_sleeping() && sleeper->collision_box().get_rect() == sleeper_rect);
+        std::vector<CollisionBox *> found;
+        scene.world.collision().overlap_rect(sleeper_rect, ALL_COLLISION_LAYERS, found);
+        assert(std::find(found.begin(), found.end(), &sleeper->collision_box()) != found.end());
+        assert(scene.record(60) == first);
+    }
+
+    // ---------- 性能: 保存与恢复的耗时, 与重新创建物体相比 ----------
+    {
+        Scene scene(2000);
+        auto &physics = scene.physics();
+        scene.run(30);
+
+        using Clock = std::chrono::high_resolution_clock;
+        const int rounds = 100;
+        PhysicsSnapshot saved;
+        physics.snapshot(saved);
+
+        auto start = Clock::now();
+        for (int i = 0; i < rounds; ++i)
+            physics.snapshot(saved);
+        double save_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / rounds;
+
+        start = Clock::now();
+        for (int i = 0; i < rounds; ++i)
+            physics.restore(saved);
+        double restore_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count() / rounds;
+
+        start = Clock::now();
+        {
+            Scene rebuilt(2000);
+        }
+        double rebuild_us = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+
+        std::cout << "2000 bodies, " << saved.byte_size() / 1024 << " KiB snapshot:\n";
+        std::cout << "  snapshot: " << save_us << " us\n";
+        std::cout << "  restore:  " << restore_us << " us\n";
+        std::cout << "  rebuild:  " << rebuild_us << " us\n";
+    }
+
+    std::cout << "Snapshot tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,178 @@
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/collision/tile_collision_map.hpp>
+
+#include "physics_arena.hpp"
+
+static void run(PhysicsManager &physics, int frames)
+{
+    for (int frame = 0; frame < frames; ++frame)
+    {
+        physics.on_update(1.0f / 60);
+        // 不做连续碰撞检测
+        assert(physics.get_impact_count() == 0 && physics.get_stats().predictions == 0);
+    }
+}
+
+// 封闭场地中的高速小物体, 返回每帧的平均耗时 (毫秒)。
+static double bullet_hell(bool speculative, int count)
+{
+    Arena arena(4000);
+    arena.physics().set_speculative_contacts(speculative);
+    arena.enclose();
+    arena.bullets(count, 3, 800, 1500, 3);
+
+    using Clock = std::chrono::high_resolution_clock;
+    auto start = Clock::now();
+    arena.run(300);
+    double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count() / 300;
+
+    // 投机接触下都还在场地内; 事件驱动的一侧只作为耗时的对照
+    if (speculative)
+        for (auto *p : arena.physics().objects())
+            assert(arena.inner().is_intersect(p->get_rect().center()));
+    return ms;
+}
+
+int main()
+{
+    // ---------- 高速物体不会穿过薄墙, 下一步按恢复系数反弹 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_speculative_contacts(true);
+
+        ObstacleObject wall(world);
+        wall.set_rect(Rect(400, 0, 2, 600));
+
+        auto *bullet = physics.create_physical_object();
+        bullet->set_rect(Rect(100, 300, 3, 3));
+        bullet->set_speed(Vec2(20000, 0));
+        bullet->set_restitution(1);
+
+        run(physics, 2);
+        assert(bullet->get_rect().right() <= 400.01f);
+        run(physics, 60);
+        assert(bullet->get_rect().right() <= 400.01f);
+        assert(bullet->get_speed().get_x() < 0);
+    }
+
+    // ---------- 相向而行的两个高速物体: 各自的扫掠都碰不到对方的起点, 仍然不会互相穿过 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_speculative_contacts(true);
+
+        auto *a = physics.create_physical_object();
+        a->set_rect(Rect(100, 300, 3, 3));
+        a->set_speed(Vec2(5000, 0));
+        auto *b = physics.create_physical_object();
+        b->set_rect(Rect(200, 300, 3, 3));
+        b->set_speed(Vec2(-5000, 0));
+
+        run(physics, 1);
+        assert(a->get_rect().right() <= b->get_rect().left() + 0.01f);
+        run(physics, 1);
+        assert(a->get_rect().right() <= b->get_rect().left() + 0.01f);
+        assert(a->get_speed().get_x() < 0 && b->get_speed().get_x() > 0);
+    }
+
+    // ---------- 斜着撞向墙角: 按最后闭合的轴选择法线, 落在墙顶上而不是被侧面挡住 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_speculative_contacts(true);
+
+        ObstacleObject block(world);
+        block.set_rect(Rect(200, 400, 200, 200));
+
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(180, 370, 10, 10));
+        p->set_speed(Vec2(1800, 1800)); // 本步横向先越过墙的左边界, 纵向后到达墙顶
+        p->set_restitution(0);
+
+        run(physics, 1);
+        assert(p->get_rect().top() <= 400.01f);
+        assert(p->get_rect().left() > 200);
+    }
+
+    // ---------- 网格: 高速落地不穿透, 贴地滑过格子之间的接缝, 单向平台可以从下方穿过 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_speculative_contacts(true);
+
+        auto &tiles = world.collision().create_tile_map(Point(0, 0), 10, 80, 60);
+        tiles.fill(0, 59, 80, 1, TileType::Solid);
+        tiles.fill(30, 40, 10, 1, TileType::OneWay);
+
+        auto *faller = physics.create_physical_object();
+        faller->set_rect(Rect(100, 100, 8, 8));
+        faller->set_speed(Vec2(0, 20000));
+        faller->set_restitution(0);
+        run(physics, 3);
+        assert(std::abs(faller->get_rect().top() - 590) < 0.1f);
+
+        auto *slider = physics.create_physical_object();
+        slider->set_rect(Rect(500, 582, 8, 8));
+        slider->set_speed(Vec2(300, 0));
+        slider->set_force(Vec2(0, 1000));
+        run(physics, 30);
+        assert(slider->get_rect().get_x() > 500 + 300 * 0.5f * 0.9f);
+        assert(std::abs(slider->get_rect().top() - 590) < 0.1f);
+
+        auto *jumper = physics.create_physical_object();
+        jumper->set_rect(Rect(340, 500, 8, 8));
+        jumper->set_speed(Vec2(0, -600));
+        jumper->set_force(Vec2(0, 1000));
+        jumper->set_restitution(0);
+        run(physics, 120);
+        // 向上穿过平台, 落回时停在平台上 (平台顶部 y = 400)
+        assert(std::abs(jumper->get_rect().top() - 400) < 0.1f);
+    }
+
+    // ---------- 叠放的一列物体在投机接触模式下同样静止 ----------
+    {
+        World world;
+        auto &physics = world.physics();
+        physics.set_speculative_contacts(true);
+        physics.set_sleep_enabled(false);
+
+        ObstacleObject floor(world);
+        floor.set_rect(Rect(0, 590, 800, 10));
+        std::vector<PhysicalObject *> stack;
+        for (int i = 0; i < 10; ++i)
+        {
+            auto *p = physics.create_physical_object();
+            p->set_rect(Rect(100, 580 - i * 10.0f, 10, 10));
+            p->set_force(Vec2(0, 1000));
+            stack.push_back(p);
+        }
+
+        run(physics, 600);
+        for (size_t i = 0; i < stack.size(); ++i)
+        {
+            // 每个接触允许 0.01 的重叠 (k_slop), 越往上累积越多
+            assert(std::abs(stack[i]->get_rect().get_y() - (580 - i * 10.0f)) < 0.02f * (i + 1));
+            assert(stack[i]->get_speed().length() < 0.1f);
+        }
+    }
+
+    // ---------- 性能: 弹幕场景下与事件驱动的连续碰撞检测对比 ----------
+    {
+        const int count = 2000;
+        double ccd_ms = bullet_hell(false, count);
+        double speculative_ms = bullet_hell(true, count);
+        std::cout << count << " bullets:\n";
+        std::cout << "  event-driven CCD:    " << ccd_ms << " ms/frame\n";
+        std::cout << "  speculative contacts: " << speculative_ms << " ms/frame\n";
+    }
+
+    std::cout << "Speculative contact tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <iostream>
+#include <chrono>
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/collision/tile_collision_map.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+
+static bool near(float a, float b) { return std::abs(a - b) < 1e-3f; }
+
+// 一排 10x10 的砖作地面, 两侧各一堵墙, 中间一块单向平台。
+static void build_level(TileCollisionMap &map)
+{
+    map.fill(0, 59, 80, 1, TileType::Solid);
+    map.fill(0, 0, 1, 60, TileType::Solid);
+    map.fill(79, 0, 1, 60, TileType::Solid);
+    map.fill(30, 40, 10, 1, TileType::OneWay);
+}
+
+static float simulate(World &world, int frames)
+{
+    auto &physics = world.physics();
+    for (int i = 0; i < 50; ++i)
+    {
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(20 + i * 15, 100 + i * 3, 10, 10));
+        p->set_speed(Vec2(0, 200));
+        p->set_force(Vec2(0, 1000));
+    }
+
+    for (int frame = 0; frame < frames; ++frame)
+        physics.on_update(1.0f / 60);
+
+    float max_top = 0;
+    for (auto *p : physics.objects())
+        max_top = std::max(max_top, p->get_rect().top());
+    return max_top;
+}
+
+int main()
+{
+    TileCollisionMap map(Point(0, 0), 10, 80, 60);
+    build_level(map);
+
+    // ---------- 按轴移动: 贴地滑动不被接缝挡住, 撞墙停在墙边 ----------
+    Rect rect(100, 580, 10, 10);
+    auto contact = map.move(rect, Vec2(200, 5));
+    assert(contact.floor && !contact.right);
+    assert(near(rect.get_x(), 300) && near(rect.top(), 590));
+
+    contact = map.move(rect, Vec2(600, 0));
+    assert(contact.right && near(rect.right(), 790));
+
+    // ---------- 单向平台: 从上方落下会被挡住, 从下方跳起可以穿过 ----------
+    rect = Rect(320, 380, 10, 10);
+    contact = map.move(rect, Vec2(0, 30));
+    assert(contact.floor && near(rect.top(), 400));
+
+    rect = Rect(320, 420, 10, 10);
+    contact = map.move(rect, Vec2(0, -50));
+    assert(!contact.ceiling && near(rect.get_y(), 370));
+
+    // ---------- 扫掠: 只计入未来的碰撞 ----------
+    Rect cell;
+    float t = map.time_to_collide(Rect(100, 500, 10, 10), Vec2(0, 100), 1.0f, &cell);
+    assert(near(t, 0.8f) && near(cell.bottom(), 590));
+    assert(map.time_to_collide(Rect(100, 580, 10, 10), Vec2(100, 0), 1.0f) < 0);
+    assert(near(map.time_to_collide(Rect(100, 580, 10, 10), Vec2(1000, 0), 1.0f), 0.68f));
+    assert(map.time_to_collide(Rect(320, 420, 10, 10), Vec2(0, -100), 1.0f) < 0);
+
+    // 斜向高速扫掠只检查扫过的格子: 与逐个格子求碰撞时间的结果一致。
+    // 格子互不相邻, 每个面都是外表面, 参考结果就是所有格子中最小的碰撞时间。
+    {
+        TileCollisionMap sparse(Point(0, 0), 10, 200, 200);
+        std::vector<Rect> cells;
+        for (int row = 1; row < 200; row += 7)
+            for (int col = (row * 3) % 5 + 1; col < 200; col += 6)
+            {
+                sparse.set_tile(col, row, TileType::Solid);
+                cells.push_back(sparse.cell_rect(col, row));
+            }
+
+        for (int i = 0; i < 2000; ++i)
+        {
+            Rect rect(5.5f + (i * 37) % 1900, 3.5f + (i * 53) % 1900, 2 + i % 7, 2 + i % 5);
+            if (sparse.is_intersect(rect))
+                continue;
+            float angle = i * 0.731f;
+            Vec2 velocity(std::cos(angle) * 3000, std::sin(angle) * 3000);
+
+            float expected = -1;
+            for (const auto &c : cells)
+            {
+                float t = rect.time_to_collide(velocity, c);
+                if (t > 0 && t <= 0.5f && (expected < 0 || t < expected))
+                    expected = t;
+            }
+            float t = sparse.time_to_collide(rect, velocity, 0.5f, &cell);
+            assert(expected < 0 ? t < 0 : near(t, expected));
+        }
+    }
+
+    assert(map.is_intersect(Rect(100, 585, 10, 10)));
+    assert(!map.is_intersect(Rect(320, 395, 10, 10)));
+
+    // ---------- 物理场景: 网格地面与 ObstacleObject 地面结果一致 ----------
+    using Clock = std::chrono::high_resolution_clock;
+    const int frames = 120;
+
+    float tile_top, obstacle_top;
+    size_t tile_boxes, obstacle_boxes;
+    double tile_ms, obstacle_ms;
+    {
+        World world;
+        build_level(world.collision().create_tile_map(Point(0, 0), 10, 80, 60));
+
+        auto start = Clock::now();
+        tile_top = simulate(world, frames);
+        tile_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        tile_boxes = world.collision().size();
+        world.physics().clear();
+    }
+    {
+        World world;
+        std::vector<ObstacleObject *> walls;
+        map.for_each_tile(
+            map.bound(),
+            [&](const Rect &cell, TileType type)
+            {
+                if (type != TileType::Solid)
+                    return;
+                walls.push_back(new ObstacleObject(world));
+                walls.back()->set_rect(cell);
+            });
+
+        auto start = Clock::now();
+        obstacle_top = simulate(world, frames);
+        obstacle_ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        obstacle_boxes = world.collision().size();
+        world.physics().clear();
+        for (auto wall : walls)
+            delete wall;
+    }
+
+    std::cout << "50 bodies x " << frames << " frames on a brick floor:\n";
+    std::cout << "  tile map:  " << tile_boxes << " boxes, " << tile_ms << " ms, lowest body at " << tile_top << "\n";
+    std::cout << "  obstacles: " << obstacle_boxes << " boxes, " << obstacle_ms << " ms, lowest body at " << obstacle_top << "\n";
+
+    assert(tile_boxes == 50);
+    assert(tile_top <= 590.01f && obstacle_top <= 590.01f);
+
+    std::cout << "Tile map tests passed!" << std::endl;
+    return 0;
+}
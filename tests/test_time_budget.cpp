@@ -0,0 +1,150 @@
+#include <iostream>
+#include <vector>
+#include <cassert>
+
+#include "physics_arena.hpp"
+
+static bool has(const PhysicsStats &stats, PhysicsDegradation degradation)
+{
+    return (stats.degradations & degradation_bit(degradation)) != 0;
+}
+
+int main()
+{
+    // ---------- 持续超时: 每步多启用一级降级, 按固定顺序, 并在统计中报告 ----------
+    {
+        // 封闭场地中互相碰撞的高速小物体
+        Arena arena(2000);
+        auto &physics = arena.physics();
+        arena.enclose();
+        arena.bullets(1500, 3, 800, 1500, 5);
+        physics.set_time_budget(1e-4f);
+
+        physics.on_update(1.0f / 60);
+        assert(physics.get_stats().degradations == 0);
+        assert(physics.get_stats().velocity_iterations == physics.get_velocity_iterations());
+        assert(physics.get_degrade_level() == 1);
+
+        physics.on_update(1.0f / 60);
+        assert(has(physics.get_stats(), PhysicsDegradation::CapImpacts));
+        assert(!has(physics.get_stats(), PhysicsDegradation::ReduceIterations));
+        assert(physics.get_stats().dropped_events > 0); // 本步超时, 剩余事件被丢弃
+        assert(physics.get_degrade_level() == 2);
+
+        physics.on_update(1.0f / 60);
+        assert(has(physics.get_stats(), PhysicsDegradation::ReduceIterations));
+        assert(physics.get_stats().velocity_iterations < physics.get_velocity_iterations());
+        assert(physics.get_stats().position_iterations <= 1);
+        assert(physics.get_degrade_level() == 3);
+
+        // 没有设置活动区域时第三级不起作用
+        physics.on_update(1.0f / 60);
+        assert(!has(physics.get_stats(), PhysicsDegradation::FreezeOffscreen));
+        assert(physics.get_degrade_level() == 3);
+
+        // 丢弃事件只损失精度: 物体仍然留在场地内
+        for (int frame = 0; frame < 60; ++frame)
+            physics.on_update(1.0f / 60);
+        for (auto *p : physics.objects())
+            assert(arena.inner().is_intersect(p->get_rect().center()));
+
+        // ---------- 负载降低后逐级恢复 ----------
+        physics.set_time_budget(1e6f);
+        physics.on_update(1.0f / 60);
+        assert(physics.get_degrade_level() == 2);
+        physics.on_update(1.0f / 60);
+        physics.on_update(1.0f / 60);
+        assert(physics.get_degrade_level() == 0);
+        physics.on_update(1.0f / 60);
+        assert(physics.get_stats().degradations == 0 && physics.get_stats().dropped_events == 0);
+    }
+
+    // ---------- 第三级: 活动区域外的物体冻结, 保留速度, 回到区域内或恢复后继续 ----------
+    {
+        World world(Rect(0, 0, 2000, 2000));
+        auto &physics = world.physics();
+        physics.set_sleep_enabled(false);
+        physics.set_active_region(Rect(0, 0, 800, 600));
+
+        auto *inside = physics.create_physical_object();
+        inside->set_rect(Rect(100, 100, 10, 10));
+        inside->set_speed(Vec2(60, 0));
+        auto *outside = physics.create_physical_object();
+        outside->set_rect(Rect(1500, 100, 10, 10));
+        outside->set_speed(Vec2(0, 120));
+        auto *far = physics.create_physical_object();
+        far->set_rect(Rect(1500, 1500, 10, 10));
+        far->set_speed(Vec2(-120, 0));
+
+        physics.set_time_budget(1e-6f);
+        for (int frame = 0; frame < 3; ++frame)
+            physics.on_update(1.0f / 60);
+        assert(physics.get_degrade_level() == 3);
+
+        physics.on_update(1.0f / 60);
+        assert(has(physics.get_stats(), PhysicsDegradation::FreezeOffscreen));
+        assert(physics.get_stats().frozen_bodies == 2);
+        assert(outside->is_frozen() && outside->is_sleeping() && far->is_frozen());
+        assert(!inside->is_frozen());
+        assert(physics.get_awake_count() == 1);
+        assert(outside->get_speed().get_y() == 120);
+
+        Rect frozen_at = outside->get_rect();
+        float inside_x = inside->get_rect().get_x();
+        for (int frame = 0; frame < 30; ++frame)
+            physics.on_update(1.0f / 60);
+        assert(outside->get_rect() == frozen_at);
+        assert(inside->get_rect().get_x() > inside_x + 25);
+
+        // 活动区域移到物体所在位置 (例如相机移动) 后解冻
+        physics.set_active_region(Rect(1000, 0, 800, 600));
+        physics.on_update(1.0f / 60);
+        assert(!outside->is_frozen() && !outside->is_sleeping());
+        assert(outside->get_rect().get_y() > frozen_at.get_y());
+        assert(far->is_frozen());
+
+        // 关闭预算后所有物体恢复模拟
+        physics.set_time_budget(0);
+        physics.on_update(1.0f / 60);
+        assert(!far->is_frozen() && physics.get_awake_count() == 3);
+        assert(far->get_speed().get_x() == -120);
+        assert(physics.get_stats().frozen_bodies == 0 && physics.get_degrade_level() == 0);
+
+        // ---------- 快照包含冻结状态 ----------
+        physics.set_time_budget(1e-6f);
+        for (int frame = 0; frame < 4; ++frame)
+            physics.on_update(1.0f / 60);
+        assert(inside->is_frozen() || far->is_frozen());
+        auto snapshot = physics.snapshot();
+        bool far_frozen = far->is_frozen();
+        physics.set_time_budget(0);
+        physics.on_update(1.0f / 60);
+        assert(!far->is_frozen());
+        assert(physics.restore(snapshot));
+        assert(far->is_frozen() == far_frozen);
+        physics.on_update(1.0f / 60);
+        assert(!far->is_frozen() && physics.get_awake_count() == 3);
+    }
+
+    // ---------- 确定性模式下忽略时间预算 ----------
+    {
+        // 封闭场地中互相碰撞的高速小物体
+        Arena arena(2000);
+        auto &physics = arena.physics();
+        arena.enclose();
+        arena.bullets(500, 3, 800, 1500, 5);
+        physics.set_deterministic(true);
+        physics.set_time_budget(1e-6f);
+        physics.set_active_region(Rect(0, 0, 100, 100));
+
+        for (int frame = 0; frame < 10; ++frame)
+        {
+            physics.on_update(1.0f / 60);
+            assert(physics.get_degrade_level() == 0);
+            assert(physics.get_stats().degradations == 0 && physics.get_stats().frozen_bodies == 0);
+        }
+    }
+
+    std::cout << "Time budget tests passed!" << std::endl;
+    return 0;
+}
@@ -0,0 +1,122 @@
+#include <iostream>
+#include <thread>
+#include <cassert>
+
+#include <echo_strike/core/world.hpp>
+#include <echo_strike/physics/physical_object.hpp>
+#include <echo_strike/physics/physics_manager.hpp>
+#include <echo_strike/physics/obstacle_object.hpp>
+#include <echo_strike/collision/collision_manager.hpp>
+#include <echo_strike/event/event_bus.hpp>
+#include <echo_strike/event/events.hpp>
+
+// 在给定世界里搭一个与 test_physics 相同的场景并推进若干帧。
+static Rect simulate(World &world)
+{
+    ObstacleObject floor(world);
+    floor.set_rect(Rect(0, 590, 800, 10));
+
+    auto &physics = world.physics();
+    for (int i = 0; i < 50; ++i)
+    {
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(20 + i * 15, 100, 10, 10));
+        p->set_speed(Vec2(0, 200));
+        p->set_force(Vec2(0, 1000));
+    }
+
+    for (int frame = 0; frame < 120; ++frame)
+        physics.on_update(1.0f / 60);
+
+    Rect result = physics.objects().front()->get_rect();
+    physics.clear();
+    return result;
+}
+
+// 一堆物体落在地面上; via_world 为真时经由 World::on_update 推进, 否则直接推进物理。
+static uint64_t settle(bool via_world)
+{
+    World world;
+    auto &physics = world.physics();
+    physics.set_deterministic(true);
+
+    ObstacleObject floor(world);
+    floor.set_rect(Rect(0, 500, 800, 100));
+    for (int i = 0; i < 30; ++i)
+    {
+        auto *p = physics.create_physical_object();
+        p->set_rect(Rect(100 + (i % 10) * 22.0f, 300 + (i / 10) * 22.0f, 20, 20));
+        p->set_speed(Vec2((i % 3 - 1) * 50.0f, 0));
+        p->set_force(Vec2(0, 1000));
+    }
+    auto *resting = physics.create_physical_object();
+    resting->set_rect(Rect(600, 480, 20, 20));
+    resting->set_force(Vec2(0, 1000));
+    assert(!resting->collision_box().get_callback());
+
+    const float ms = 1000.0f / 60;
+    for (int frame = 0; frame < 300; ++frame)
+    {
+        if (via_world)
+            world.on_update(ms);
+        else
+            physics.on_frame(ms / 1000.0f);
+        assert(resting->get_speed() == Vec2(0, 0));
+    }
+    return physics.get_state_hash();
+}
+
+int main()
+{
+    World world_a, world_b;
+    Rect result_a, result_b;
+
+    // 两个独立的世界在不同线程上推进, 互不干扰。
+    std::thread thread_a([&]()
+                         { result_a = simulate(world_a); });
+    std::thread thread_b([&]()
+                         { result_b = simulate(world_b); });
+    thread_a.join();
+    thread_b.join();
+
+    assert(result_a == result_b);
+    assert(world_a.collision().size() == 0 && world_b.collision().size() == 0);
+
+    // 默认世界不受影响
+    assert(CollisionManager::instance().size() == 0);
+    assert(&PhysicsManager::instance() == &World::instance().physics());
+
+    // 碰撞响应只由物理步进完成: 之后的 process_collide 不再改变速度, 结果与直接推进物理逐位相同,
+    // 静止在地面上的物体速度始终为 0。
+    assert(settle(true) == settle(false));
+
+    // 默认世界的事件发布到 EventBus::instance(), 显式创建的世界使用自己的总线
+    assert(&World::instance().events() == &EventBus::instance());
+    assert(&world_a.events() != &EventBus::instance() && &world_a.events() != &world_b.events());
+
+    // 在一个世界里放两个相交的碰撞盒, 推进一帧后删除
+    auto collide_once = [](World &world)
+    {
+        auto &collision = world.collision();
+        auto *a = collision.create_collision_box(), *b = collision.create_collision_box();
+        a->set_src(CollisionLayer::Physics), b->set_src(CollisionLayer::Obstacle);
+        a->add_dst(CollisionLayer::Obstacle);
+        a->set_rect(Rect(0, 0, 10, 10)), b->set_rect(Rect(5, 5, 10, 10));
+        world.on_update(16);
+        collision.destroy_collision_box(a);
+        collision.destroy_collision_box(b);
+    };
+
+    size_t default_batches = 0, own_batches = 0;
+    EventBus::instance().subscribe<CollisionBatchEvent>([&](CollisionBatchEvent *)
+                                                        { ++default_batches; });
+    world_a.events().subscribe<CollisionBatchEvent>([&](CollisionBatchEvent *)
+                                                    { ++own_batches; });
+    collide_once(World::instance());
+    assert(default_batches == 1 && own_batches == 0);
+    collide_once(world_a);
+    assert(default_batches == 1 && own_batches == 1);
+
+    std::cout << "World tests passed! " << result_a << std::endl;
+    return 0;
+}